@@ -0,0 +1,35 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+
+namespace bench
+{
+template <class T>
+inline void do_not_optimize(const T& value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+template <class F>
+double measure_ns(std::size_t ops, F&& f, int repeat = 5)
+{
+    f();
+    auto best = std::numeric_limits<double>::max();
+    for (int i = 0; i < repeat; ++i) {
+        const auto begin = std::chrono::steady_clock::now();
+        f();
+        const auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(end - begin).count());
+    }
+    return best / static_cast<double>(ops);
+}
+
+inline void report(const char* type, const char* op, double ns)
+{
+    std::printf("%-8s %-16s %10.2f ns/op\n", type, op, ns);
+}
+}  // namespace bench
@@ -0,0 +1,228 @@
+#include "bench.hpp"
+#include "fixed_rational.hpp"
+#include "rational.hpp"
+#include "rational_algorithm.hpp"
+#include "rational_array.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <ratio>
+#include <span>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t size = 4096;
+constexpr std::size_t rounds = 64;
+
+template <std::signed_integral T>
+std::vector<Rational<T>> make_operands(std::mt19937_64& engine)
+{
+    using Unsigned = std::make_unsigned_t<T>;
+    constexpr auto bits = std::numeric_limits<Unsigned>::digits / 2 - 1;
+    std::uniform_int_distribution<std::int64_t> numer{-(std::int64_t{1} << (bits - 1)), (std::int64_t{1} << (bits - 1)) - 1};
+    std::uniform_int_distribution<std::uint64_t> denom{1, (std::uint64_t{1} << bits) - 1};
+
+    std::vector<Rational<T>> result;
+    result.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        auto n = static_cast<T>(numer(engine));
+        result.emplace_back(n == 0 ? T{1} : n, static_cast<Unsigned>(denom(engine)));
+    }
+    return result;
+}
+
+template <std::signed_integral T, class F>
+void run(const char* type, const char* name, const std::vector<Rational<T>>& lhs, const std::vector<Rational<T>>& rhs, F op)
+{
+    const auto ns = bench::measure_ns(size * rounds, [&] {
+        for (std::size_t r = 0; r < rounds; ++r) {
+            for (std::size_t i = 0; i < size; ++i) {
+                bench::do_not_optimize(op(lhs[i], rhs[i]));
+            }
+        }
+    });
+    bench::report(type, name, ns);
+}
+
+template <std::signed_integral T>
+void run_all(const char* type, std::mt19937_64& engine)
+{
+    using Unsigned = std::make_unsigned_t<T>;
+    const auto lhs = make_operands<T>(engine), rhs = make_operands<T>(engine);
+
+    run(type, "construct", lhs, rhs, [](const auto& a, const auto& b) { return Rational<T>{static_cast<T>(a.numer() * b.numer()), static_cast<Unsigned>(a.denom() * b.denom())}; });
+    run(type, "+", lhs, rhs, [](const auto& a, const auto& b) { return a + b; });
+    run(type, "-", lhs, rhs, [](const auto& a, const auto& b) { return a - b; });
+    run(type, "*", lhs, rhs, [](const auto& a, const auto& b) { return a * b; });
+    run(type, "/", lhs, rhs, [](const auto& a, const auto& b) { return a / b; });
+    run(type, "+ integer", lhs, rhs, [](const auto& a, const auto& b) { return a + b.numer(); });
+    run(type, "* integer", lhs, rhs, [](const auto& a, const auto& b) { return a * b.numer(); });
+    run(type, "/ integer", lhs, rhs, [](const auto& a, const auto& b) { return a / b.numer(); });
+    run(type, "<", lhs, rhs, [](const auto& a, const auto& b) { return a < b; });
+
+    // both on the same operands, the product truncated to Unsigned
+    const auto product = [](const auto& a, const auto& b) { return static_cast<Unsigned>(a.denom() * b.denom()); };
+    run(type, "std::gcd", lhs, rhs, [product](const auto& a, const auto& b) { return std::gcd(product(a, b), b.denom()); });
+    run(type, "binary_gcd", lhs, rhs, [product](const auto& a, const auto& b) { return rational::detail::binary_gcd(product(a, b), b.denom()); });
+}
+
+template <std::signed_integral T, class F>
+void run_array(const char* type, const char* name, const RationalArray<T>& lhs, const RationalArray<T>& rhs, F op)
+{
+    const auto ns = bench::measure_ns(size * rounds, [&] {
+        for (std::size_t r = 0; r < rounds; ++r) {
+            bench::do_not_optimize(op(lhs, rhs));
+        }
+    });
+    bench::report(type, name, ns);
+}
+
+template <std::signed_integral T>
+void run_array_all(const char* type, std::mt19937_64& engine)
+{
+    const auto lhs_values = make_operands<T>(engine), rhs_values = make_operands<T>(engine);
+    const RationalArray<T> lhs{lhs_values.begin(), lhs_values.end()}, rhs{rhs_values.begin(), rhs_values.end()};
+
+    run_array(type, "array +", lhs, rhs, [](const auto& a, const auto& b) { return a + b; });
+    run_array(type, "array *", lhs, rhs, [](const auto& a, const auto& b) { return a * b; });
+    run_array(type, "array /", lhs, rhs, [](const auto& a, const auto& b) { return a / b; });
+    run_array(type, "array * integer", lhs, rhs, [](const auto& a, const auto& b) { return a * b.numers()[0]; });
+    run_array(type, "array <", lhs, rhs, [](const auto& a, const auto& b) { return a < b; });
+}
+
+template <std::signed_integral T>
+void run_fused_all(const char* type, std::mt19937_64& engine)
+{
+    constexpr std::size_t window = 16;
+    constexpr std::array<int, 10> denoms{1, 2, 4, 5, 8, 10, 20, 25, 50, 100};
+    std::uniform_int_distribution<int> numer{-50, 50};
+    std::uniform_int_distribution<std::size_t> denom{0, denoms.size() - 1};
+
+    std::vector<Rational<T>> lhs, rhs;
+    for (std::size_t i = 0; i < size; ++i) {
+        lhs.emplace_back(static_cast<T>(numer(engine)), static_cast<T>(denoms[denom(engine)]));
+        rhs.emplace_back(static_cast<T>(numer(engine)), static_cast<T>(denoms[denom(engine)]));
+    }
+    const auto measure = [&](const char* name, auto op) {
+        const auto ns = bench::measure_ns(size * rounds, [&] {
+            for (std::size_t r = 0; r < rounds; ++r) {
+                for (std::size_t i = 0; i < size; i += window) {
+                    bench::do_not_optimize(op(std::span{lhs}.subspan(i, window), std::span{rhs}.subspan(i, window)));
+                }
+            }
+        });
+        bench::report(type, name, ns);
+    };
+
+    measure("sum chained", [](auto a, auto) {
+        Rational<T> result{0};
+        for (const auto& value : a) {
+            result += value;
+        }
+        return result;
+    });
+    measure("sum fused", [](auto a, auto) { return rational::sum(a); });
+    measure("dot chained", [](auto a, auto b) {
+        Rational<T> result{0};
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            result += a[i] * b[i];
+        }
+        return result;
+    });
+    measure("dot fused", [](auto a, auto b) { return rational::dot(a, b); });
+}
+
+template <std::signed_integral T>
+void run_floating_all(const char* type, std::mt19937_64& engine)
+{
+    using Unsigned = std::make_unsigned_t<T>;
+    std::uniform_int_distribution<T> numer{std::numeric_limits<T>::min(), std::numeric_limits<T>::max()};
+    std::uniform_int_distribution<Unsigned> denom{1, std::numeric_limits<Unsigned>::max()};
+    std::uniform_real_distribution<double> real{-1000.0, 1000.0};
+
+    std::vector<Rational<T>> values;
+    std::vector<double> reals;
+    for (std::size_t i = 0; i < size; ++i) {
+        values.emplace_back(numer(engine), denom(engine));
+        reals.push_back(real(engine));
+    }
+    const auto measure = [&](const char* name, const auto& inputs, auto op) {
+        const auto ns = bench::measure_ns(size * rounds, [&] {
+            for (std::size_t r = 0; r < rounds; ++r) {
+                for (const auto& input : inputs) {
+                    bench::do_not_optimize(op(input));
+                }
+            }
+        });
+        bench::report(type, name, ns);
+    };
+
+    measure("double cast", values, [](const auto& a) { return static_cast<double>(a.numer()) / static_cast<double>(a.denom()); });
+    measure("to_double", values, [](const auto& a) { return a.to_double(); });
+    constexpr Unsigned max_denominator = 1000;
+    measure("from double scaled", reals, [](double a) { return Rational<T>{static_cast<T>(std::llround(a * max_denominator)), max_denominator}; });
+    measure("from_floating", reals, [](double a) { return Rational<T>::from_floating(a, max_denominator); });
+    measure("from_floating exact", reals, [](double a) { return Rational<T>::from_floating(a); });
+}
+
+template <std::signed_integral T, class Scale>
+void run_fixed_all(const char* type, std::mt19937_64& engine)
+{
+    using Fixed = FixedRational<T, Scale>;
+    std::uniform_int_distribution<T> numer{1, sizeof(T) > sizeof(std::int32_t) ? 1'000'000 : 10'000};
+
+    std::vector<Rational<T>> lhs, rhs;
+    std::vector<Fixed> fixed_lhs, fixed_rhs;
+    for (std::size_t i = 0; i < size; ++i) {
+        fixed_lhs.push_back(Fixed::from_numer(numer(engine)));
+        fixed_rhs.push_back(Fixed::from_numer(numer(engine)));
+        lhs.push_back(fixed_lhs.back());
+        rhs.push_back(fixed_rhs.back());
+    }
+    const auto measure = [&](const char* name, const auto& a, const auto& b, auto op) {
+        auto result = a;
+        const auto ns = bench::measure_ns(size * rounds, [&] {
+            for (std::size_t r = 0; r < rounds; ++r) {
+                for (std::size_t i = 0; i < size; ++i) {
+                    result[i] = op(a[i], b[i]);
+                }
+                bench::do_not_optimize(result.data());
+            }
+        });
+        bench::report(type, name, ns);
+    };
+
+    measure("+ prices", lhs, rhs, [](const auto& a, const auto& b) { return a + b; });
+    measure("fixed +", fixed_lhs, fixed_rhs, [](const auto& a, const auto& b) { return a + b; });
+    measure("* prices", lhs, rhs, [](const auto& a, const auto& b) { return Rational<T>{Fixed{a * b}}; });
+    measure("fixed *", fixed_lhs, fixed_rhs, [](const auto& a, const auto& b) { return a * b; });
+    measure("/ prices", lhs, rhs, [](const auto& a, const auto& b) { return Rational<T>{Fixed{a / b}}; });
+    measure("fixed /", fixed_lhs, fixed_rhs, [](const auto& a, const auto& b) { return a / b; });
+}
+}  // namespace
+
+int main()
+{
+    std::mt19937_64 engine{0};
+    run_all<std::int8_t>("int8", engine);
+    run_all<std::int16_t>("int16", engine);
+    run_all<std::int32_t>("int32", engine);
+    run_all<std::int64_t>("int64", engine);
+
+    run_array_all<std::int16_t>("int16", engine);
+    run_array_all<std::int32_t>("int32", engine);
+
+    run_fused_all<std::int32_t>("int32", engine);
+    run_fused_all<std::int64_t>("int64", engine);
+
+    run_floating_all<std::int32_t>("int32", engine);
+    run_floating_all<std::int64_t>("int64", engine);
+
+    run_fixed_all<std::int32_t, std::centi>("int32", engine);
+    run_fixed_all<std::int64_t, std::ratio<1, 10000>>("int64", engine);
+}
@@ -0,0 +1,109 @@
+#include "bench.hpp"
+#include "big_rational.hpp"
+#include "rational_matrix.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Gaussian elimination and back substitution with the operators of Value, one entry at a time
+template <class Value>
+std::vector<Value> gauss_solve(std::vector<Value> matrix, std::vector<Value> rhs)
+{
+    const auto n = rhs.size();
+    for (std::size_t col = 0; col < n; ++col) {
+        auto pivot = col;
+        while (pivot < n && matrix[pivot * n + col] == Value{0}) {
+            ++pivot;
+        }
+        if (pivot == n) {
+            throw std::range_error{"matrix is singular"};
+        }
+        std::swap_ranges(matrix.begin() + static_cast<std::ptrdiff_t>(pivot * n), matrix.begin() + static_cast<std::ptrdiff_t>((pivot + 1) * n),
+            matrix.begin() + static_cast<std::ptrdiff_t>(col * n));
+        std::swap(rhs[pivot], rhs[col]);
+        for (auto i = col + 1; i < n; ++i) {
+            const auto factor = matrix[i * n + col] / matrix[col * n + col];
+            for (auto j = col; j < n; ++j) {
+                matrix[i * n + j] -= factor * matrix[col * n + j];
+            }
+            rhs[i] -= factor * rhs[col];
+        }
+    }
+    for (auto i = n; i-- > 0;) {
+        for (auto j = i + 1; j < n; ++j) {
+            rhs[i] -= matrix[i * n + j] * rhs[j];
+        }
+        rhs[i] /= matrix[i * n + i];
+    }
+    return rhs;
+}
+
+void report_overflow(const char* type, const char* op)
+{
+    std::printf("%-8s %-16s %10s\n", type, op, "overflow");
+}
+}  // namespace
+
+// usage: rational_matrix_bench [max threads] [max size]
+// The right-hand side is A * x for a small x, so every solution fits Rational<int64_t> while the
+// elimination itself does not; determinants are taken of L * U with unit L and a diagonal of +-1
+int main(int argc, char** argv)
+{
+    const std::size_t max_threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t max_size = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64;
+
+    std::mt19937_64 engine{0};
+    std::uniform_int_distribution<std::int64_t> numer{-9, 9}, denom{1, 4};
+    const auto random = [&] { return Rational<std::int64_t>{numer(engine), denom(engine)}; };
+    for (std::size_t size = 4; size <= max_size; size *= 2) {
+        RationalMatrix<std::int64_t> matrix{size, size}, lower{size, size}, upper{size, size};
+        std::vector<Rational<std::int64_t>> solution, rhs;
+        for (auto& value : matrix.values()) {
+            value = random();
+        }
+        for (std::size_t i = 0; i < size; ++i) {
+            solution.push_back(random());
+            lower(i, i) = Rational<std::int64_t>{1};
+            upper(i, i) = Rational<std::int64_t>{i % 2 == 0 ? 1 : -1};
+            for (std::size_t j = 0; j < i; ++j) {
+                lower(i, j) = Rational<std::int64_t>{numer(engine)};
+                upper(j, i) = Rational<std::int64_t>{numer(engine)};
+            }
+        }
+        for (std::size_t i = 0; i < size; ++i) {
+            rhs.push_back(rational::dot(matrix.row(i), solution));
+        }
+        const auto product = lower * upper;
+
+        const std::vector<Rational<std::int64_t>> entries{matrix.values().begin(), matrix.values().end()};
+        const std::vector<BigRational> big_entries{entries.begin(), entries.end()}, big_rhs{rhs.begin(), rhs.end()};
+
+        const auto type = "n=" + std::to_string(size);
+        const int repeat = size <= 16 ? 5 : 1;
+        try {
+            bench::report(type.c_str(), "gauss int64", bench::measure_ns(1, [&] { bench::do_not_optimize(gauss_solve(entries, rhs)); }, repeat));
+        } catch (const std::overflow_error&) {
+            report_overflow(type.c_str(), "gauss int64");
+        }
+        bench::report(type.c_str(), "gauss big", bench::measure_ns(1, [&] { bench::do_not_optimize(gauss_solve(big_entries, big_rhs)); }, repeat));
+
+        for (std::size_t threads = 1; threads <= max_threads; ++threads) {
+            rational::ThreadPool pool{threads};
+            const auto name = [threads](const char* op) { return std::string{op} + " x" + std::to_string(threads); };
+            bench::report(type.c_str(), name("solve").c_str(), bench::measure_ns(1, [&] { bench::do_not_optimize(matrix.solve(rhs, pool)); }, repeat));
+            bench::report(type.c_str(), name("rank").c_str(), bench::measure_ns(1, [&] { bench::do_not_optimize(matrix.rank(pool)); }, repeat));
+            bench::report(type.c_str(), name("determinant").c_str(), bench::measure_ns(1, [&] { bench::do_not_optimize(product.determinant(pool)); }, repeat));
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#include "bench.hpp"
+#include "rational_parallel.hpp"
+
+#include <algorithm>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// usage: rational_parallel_bench [max threads] [size]
+int main(int argc, char** argv)
+{
+    const std::size_t max_threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t size = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::size_t{1} << 22;
+
+    std::mt19937_64 engine{0};
+    std::uniform_int_distribution<std::int64_t> numer{-1'000'000, 1'000'000};
+    std::uniform_int_distribution<int> shift{0, 6};
+    std::vector<Rational<std::int64_t>> values, weights;
+    for (std::size_t i = 0; i < size; ++i) {
+        values.emplace_back(numer(engine), std::int64_t{1} << shift(engine));
+        weights.emplace_back(numer(engine) % 1000, std::int64_t{1} << shift(engine));
+    }
+
+    auto sorted = values;
+    bench::report("int64", "std::sort", bench::measure_ns(size, [&] {
+        sorted = values;
+        std::sort(sorted.begin(), sorted.end());
+    }, 3));
+
+    for (std::size_t threads = 1; threads <= max_threads; ++threads) {
+        rational::ThreadPool pool{threads};
+        const auto name = [threads](const char* op) { return std::string{op} + " x" + std::to_string(threads); };
+
+        bench::report("int64", name("parallel_sum").c_str(), bench::measure_ns(size, [&] { bench::do_not_optimize(rational::parallel_sum(values, pool)); }, 3));
+        bench::report("int64", name("parallel_dot").c_str(), bench::measure_ns(size, [&] { bench::do_not_optimize(rational::parallel_dot(values, weights, pool)); }, 3));
+        bench::report("int64", name("parallel_sort").c_str(), bench::measure_ns(size, [&] {
+            sorted = values;
+            rational::parallel_sort(sorted, pool);
+        }, 3));
+    }
+}
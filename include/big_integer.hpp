@@ -0,0 +1,90 @@
+#pragma once
+
+#include "rational_gcd.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace rational::detail
+{
+template <class Allocator = std::allocator<std::uint64_t>>
+struct BigInteger {
+    using Limb = std::uint64_t;
+    using Limbs = std::vector<Limb, Allocator>;
+    using allocator_type = Allocator;
+
+    explicit BigInteger(const Allocator& = Allocator{});
+    BigInteger(bool negative, uint128_t magnitude, const Allocator& = Allocator{});
+    BigInteger(const BigInteger&, const Allocator&);
+
+    BigInteger(const BigInteger&) = default;
+    BigInteger(BigInteger&&) noexcept = default;
+    BigInteger& operator=(const BigInteger&) = default;
+    BigInteger& operator=(BigInteger&&) noexcept = default;
+
+    allocator_type get_allocator() const noexcept { return limbs_.get_allocator(); }
+    const Limbs& limbs() const noexcept { return limbs_; }
+    bool is_zero() const noexcept { return limbs_.empty(); }
+    bool negative() const noexcept { return negative_; }
+    int bit_width() const noexcept;
+    bool fits_magnitude(int bits) const noexcept { return bit_width() <= bits; }
+    uint128_t low_magnitude() const noexcept;
+    Limb top_bits(int shift) const noexcept;
+
+    BigInteger& negate() noexcept;
+    BigInteger& abs() noexcept;
+
+    BigInteger& operator+=(const BigInteger&);
+    BigInteger& operator-=(const BigInteger&);
+    BigInteger& operator*=(const BigInteger&);
+    BigInteger& operator*=(Limb);
+    BigInteger& operator/=(const BigInteger&);
+    BigInteger& operator%=(const BigInteger&);
+    BigInteger& operator<<=(int);
+    BigInteger& operator>>=(int);
+
+    static void divide(const BigInteger& dividend, const BigInteger& divisor, BigInteger& quotient, BigInteger& remainder);
+    static BigInteger gcd(BigInteger, BigInteger);
+
+    static int compare_magnitude(const BigInteger&, const BigInteger&) noexcept;
+
+private:
+    Limbs limbs_;
+    bool negative_;
+
+    BigInteger& trim() noexcept;
+    BigInteger& add_signed(const BigInteger&, bool negative);
+
+    static void add_magnitude(Limbs&, const Limbs&);
+    static void subtract_magnitude(Limbs&, const Limbs&);
+    static void multiply_magnitude(const Limbs&, const Limbs&, Limbs&);
+    static Limb divide_small(Limbs&, Limb);
+    static void divide_magnitude(const Limbs&, const Limbs&, Limbs&, Limbs&);
+    static BigInteger combine(std::int64_t, const BigInteger&, std::int64_t, const BigInteger&);
+};
+
+template <class Allocator>
+bool operator==(const BigInteger<Allocator>&, const BigInteger<Allocator>&) noexcept;
+template <class Allocator>
+std::strong_ordering operator<=>(const BigInteger<Allocator>&, const BigInteger<Allocator>&) noexcept;
+
+template <class Allocator>
+BigInteger<Allocator> operator+(const BigInteger<Allocator>&, const BigInteger<Allocator>&);
+template <class Allocator>
+BigInteger<Allocator> operator-(const BigInteger<Allocator>&, const BigInteger<Allocator>&);
+template <class Allocator>
+BigInteger<Allocator> operator*(const BigInteger<Allocator>&, const BigInteger<Allocator>&);
+template <class Allocator>
+BigInteger<Allocator> operator/(const BigInteger<Allocator>&, const BigInteger<Allocator>&);
+template <class Allocator>
+BigInteger<Allocator> operator%(const BigInteger<Allocator>&, const BigInteger<Allocator>&);
+}  // namespace rational::detail
+
+#include "big_integer.ipp"
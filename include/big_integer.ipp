@@ -0,0 +1,459 @@
+#pragma once
+
+#include "big_integer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+namespace rational::detail
+{
+template <class Allocator>
+BigInteger<Allocator>::BigInteger(const Allocator& allocator) : limbs_(allocator), negative_{false}
+{
+}
+template <class Allocator>
+BigInteger<Allocator>::BigInteger(bool negative, uint128_t magnitude, const Allocator& allocator) : limbs_(allocator), negative_{negative}
+{
+    if (magnitude != 0) {
+        limbs_.push_back(static_cast<Limb>(magnitude));
+        limbs_.push_back(static_cast<Limb>(magnitude >> 64));
+    }
+    trim();
+}
+template <class Allocator>
+BigInteger<Allocator>::BigInteger(const BigInteger& other, const Allocator& allocator) : limbs_(other.limbs_, allocator), negative_{other.negative_}
+{
+}
+
+template <class Allocator>
+int BigInteger<Allocator>::bit_width() const noexcept
+{
+    if (limbs_.empty()) {
+        return 0;
+    }
+    return static_cast<int>((limbs_.size() - 1) * 64 + std::bit_width(limbs_.back()));
+}
+template <class Allocator>
+uint128_t BigInteger<Allocator>::low_magnitude() const noexcept
+{
+    uint128_t result = limbs_.empty() ? 0 : limbs_[0];
+    if (limbs_.size() > 1) {
+        result |= uint128_t{limbs_[1]} << 64;
+    }
+    return result;
+}
+template <class Allocator>
+auto BigInteger<Allocator>::top_bits(int shift) const noexcept -> Limb
+{
+    const auto index = static_cast<std::size_t>(shift / 64);
+    const auto offset = shift % 64;
+    if (index >= limbs_.size()) {
+        return 0;
+    }
+    auto result = limbs_[index] >> offset;
+    if (offset != 0 && index + 1 < limbs_.size()) {
+        result |= limbs_[index + 1] << (64 - offset);
+    }
+    return result;
+}
+
+template <class Allocator>
+auto BigInteger<Allocator>::trim() noexcept -> BigInteger&
+{
+    while (!limbs_.empty() && limbs_.back() == 0) {
+        limbs_.pop_back();
+    }
+    if (limbs_.empty()) {
+        negative_ = false;
+    }
+    return *this;
+}
+template <class Allocator>
+auto BigInteger<Allocator>::negate() noexcept -> BigInteger&
+{
+    negative_ = !negative_ && !limbs_.empty();
+    return *this;
+}
+template <class Allocator>
+auto BigInteger<Allocator>::abs() noexcept -> BigInteger&
+{
+    negative_ = false;
+    return *this;
+}
+
+template <class Allocator>
+int BigInteger<Allocator>::compare_magnitude(const BigInteger& lhs, const BigInteger& rhs) noexcept
+{
+    if (lhs.limbs_.size() != rhs.limbs_.size()) {
+        return lhs.limbs_.size() < rhs.limbs_.size() ? -1 : 1;
+    }
+    for (auto i = lhs.limbs_.size(); i-- > 0;) {
+        if (lhs.limbs_[i] != rhs.limbs_[i]) {
+            return lhs.limbs_[i] < rhs.limbs_[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+template <class Allocator>
+void BigInteger<Allocator>::add_magnitude(Limbs& lhs, const Limbs& rhs)
+{
+    if (lhs.size() < rhs.size()) {
+        lhs.resize(rhs.size());
+    }
+    Limb carry = 0;
+    std::size_t i = 0;
+    for (; i < rhs.size(); ++i) {
+        const auto sum = uint128_t{lhs[i]} + rhs[i] + carry;
+        lhs[i] = static_cast<Limb>(sum);
+        carry = static_cast<Limb>(sum >> 64);
+    }
+    for (; carry != 0 && i < lhs.size(); ++i) {
+        carry = ++lhs[i] == 0 ? 1 : 0;
+    }
+    if (carry != 0) {
+        lhs.push_back(carry);
+    }
+}
+template <class Allocator>
+void BigInteger<Allocator>::subtract_magnitude(Limbs& lhs, const Limbs& rhs)
+{
+    Limb borrow = 0;
+    std::size_t i = 0;
+    for (; i < rhs.size(); ++i) {
+        const auto difference = uint128_t{lhs[i]} - rhs[i] - borrow;
+        lhs[i] = static_cast<Limb>(difference);
+        borrow = static_cast<Limb>(difference >> 64) != 0 ? 1 : 0;
+    }
+    for (; borrow != 0 && i < lhs.size(); ++i) {
+        borrow = lhs[i]-- == 0 ? 1 : 0;
+    }
+}
+template <class Allocator>
+void BigInteger<Allocator>::multiply_magnitude(const Limbs& lhs, const Limbs& rhs, Limbs& result)
+{
+    result.assign(lhs.size() + rhs.size(), 0);
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        Limb carry = 0;
+        for (std::size_t j = 0; j < rhs.size(); ++j) {
+            const auto product = uint128_t{lhs[i]} * rhs[j] + result[i + j] + carry;
+            result[i + j] = static_cast<Limb>(product);
+            carry = static_cast<Limb>(product >> 64);
+        }
+        result[i + rhs.size()] = carry;
+    }
+}
+template <class Allocator>
+auto BigInteger<Allocator>::divide_small(Limbs& dividend, Limb divisor) -> Limb
+{
+    Limb remainder = 0;
+    for (auto i = dividend.size(); i-- > 0;) {
+        const auto current = (uint128_t{remainder} << 64) | dividend[i];
+        dividend[i] = static_cast<Limb>(current / divisor);
+        remainder = static_cast<Limb>(current % divisor);
+    }
+    return remainder;
+}
+// Knuth's Algorithm D on 64-bit limbs
+template <class Allocator>
+void BigInteger<Allocator>::divide_magnitude(const Limbs& dividend, const Limbs& divisor, Limbs& quotient, Limbs& remainder)
+{
+    const auto n = divisor.size();
+    if (dividend.size() < n) {
+        quotient.clear();
+        remainder.assign(dividend.begin(), dividend.end());
+        return;
+    }
+    if (n == 1) {
+        quotient.assign(dividend.begin(), dividend.end());
+        const auto rest = divide_small(quotient, divisor[0]);
+        remainder.assign(rest == 0 ? 0 : 1, rest);
+        return;
+    }
+
+    const auto m = dividend.size() - n;
+    const auto shift = std::countl_zero(divisor.back());
+    Limbs normalized_divisor(n, 0, divisor.get_allocator()), normalized(dividend.size() + 1, 0, dividend.get_allocator());
+    for (std::size_t i = n; i-- > 0;) {
+        normalized_divisor[i] = (divisor[i] << shift) | (shift != 0 && i > 0 ? divisor[i - 1] >> (64 - shift) : 0);
+    }
+    normalized[dividend.size()] = shift != 0 ? dividend.back() >> (64 - shift) : 0;
+    for (std::size_t i = dividend.size(); i-- > 0;) {
+        normalized[i] = (dividend[i] << shift) | (shift != 0 && i > 0 ? dividend[i - 1] >> (64 - shift) : 0);
+    }
+
+    quotient.assign(m + 1, 0);
+    const auto top = normalized_divisor[n - 1], second = normalized_divisor[n - 2];
+    for (std::size_t j = m + 1; j-- > 0;) {
+        const auto numer = (uint128_t{normalized[j + n]} << 64) | normalized[j + n - 1];
+        auto estimate = numer / top, rest = numer % top;
+        while ((estimate >> 64) != 0 || estimate * second > ((rest << 64) | normalized[j + n - 2])) {
+            --estimate;
+            rest += top;
+            if ((rest >> 64) != 0) {
+                break;
+            }
+        }
+
+        int128_t borrow = 0, difference = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto product = estimate * normalized_divisor[i];
+            difference = int128_t{normalized[i + j]} - borrow - static_cast<int128_t>(static_cast<Limb>(product));
+            normalized[i + j] = static_cast<Limb>(difference);
+            borrow = static_cast<int128_t>(product >> 64) - (difference >> 64);
+        }
+        difference = int128_t{normalized[j + n]} - borrow;
+        normalized[j + n] = static_cast<Limb>(difference);
+
+        quotient[j] = static_cast<Limb>(estimate);
+        if (difference < 0) {
+            --quotient[j];
+            Limb carry = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                const auto sum = uint128_t{normalized[i + j]} + normalized_divisor[i] + carry;
+                normalized[i + j] = static_cast<Limb>(sum);
+                carry = static_cast<Limb>(sum >> 64);
+            }
+            normalized[j + n] += carry;
+        }
+    }
+
+    remainder.assign(n, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        remainder[i] = (normalized[i] >> shift) | (shift != 0 ? normalized[i + 1] << (64 - shift) : 0);
+    }
+}
+
+template <class Allocator>
+auto BigInteger<Allocator>::add_signed(const BigInteger& other, bool negative) -> BigInteger&
+{
+    if (this == &other) {
+        return add_signed(BigInteger{other}, negative);
+    }
+    if (other.is_zero()) {
+        return *this;
+    }
+    if (is_zero() || negative_ == negative) {
+        negative_ = negative;
+        add_magnitude(limbs_, other.limbs_);
+    } else if (compare_magnitude(*this, other) >= 0) {
+        subtract_magnitude(limbs_, other.limbs_);
+    } else {
+        Limbs result(other.limbs_, limbs_.get_allocator());
+        subtract_magnitude(result, limbs_);
+        limbs_.swap(result);
+        negative_ = negative;
+    }
+    return trim();
+}
+template <class Allocator>
+auto BigInteger<Allocator>::operator+=(const BigInteger& other) -> BigInteger&
+{
+    return add_signed(other, other.negative_);
+}
+template <class Allocator>
+auto BigInteger<Allocator>::operator-=(const BigInteger& other) -> BigInteger&
+{
+    return add_signed(other, !other.negative_);
+}
+template <class Allocator>
+auto BigInteger<Allocator>::operator*=(const BigInteger& other) -> BigInteger&
+{
+    if (is_zero() || other.is_zero()) {
+        limbs_.clear();
+        return trim();
+    }
+    Limbs result(limbs_.get_allocator());
+    multiply_magnitude(limbs_, other.limbs_, result);
+    limbs_.swap(result);
+    negative_ = negative_ != other.negative_;
+    return trim();
+}
+template <class Allocator>
+auto BigInteger<Allocator>::operator*=(Limb other) -> BigInteger&
+{
+    Limb carry = 0;
+    for (auto& limb : limbs_) {
+        const auto product = uint128_t{limb} * other + carry;
+        limb = static_cast<Limb>(product);
+        carry = static_cast<Limb>(product >> 64);
+    }
+    if (carry != 0) {
+        limbs_.push_back(carry);
+    }
+    return trim();
+}
+template <class Allocator>
+void BigInteger<Allocator>::divide(const BigInteger& dividend, const BigInteger& divisor, BigInteger& quotient, BigInteger& remainder)
+{
+    if (divisor.is_zero()) {
+        throw std::range_error{"division of BigInteger by 0"};
+    }
+    Limbs quotient_limbs(quotient.limbs_.get_allocator()), remainder_limbs(remainder.limbs_.get_allocator());
+    divide_magnitude(dividend.limbs_, divisor.limbs_, quotient_limbs, remainder_limbs);
+    quotient.limbs_.swap(quotient_limbs);
+    quotient.negative_ = dividend.negative_ != divisor.negative_;
+    quotient.trim();
+    remainder.limbs_.swap(remainder_limbs);
+    remainder.negative_ = dividend.negative_;
+    remainder.trim();
+}
+template <class Allocator>
+auto BigInteger<Allocator>::operator/=(const BigInteger& other) -> BigInteger&
+{
+    BigInteger remainder{limbs_.get_allocator()};
+    divide(BigInteger{*this}, other, *this, remainder);
+    return *this;
+}
+template <class Allocator>
+auto BigInteger<Allocator>::operator%=(const BigInteger& other) -> BigInteger&
+{
+    BigInteger quotient{limbs_.get_allocator()};
+    divide(BigInteger{*this}, other, quotient, *this);
+    return *this;
+}
+template <class Allocator>
+auto BigInteger<Allocator>::operator<<=(int bits) -> BigInteger&
+{
+    if (is_zero() || bits == 0) {
+        return *this;
+    }
+    const auto limbs = static_cast<std::size_t>(bits / 64);
+    const auto offset = bits % 64;
+    limbs_.resize(limbs_.size() + limbs + 1, 0);
+    for (auto i = limbs_.size(); i-- > limbs;) {
+        const auto source = i - limbs;
+        limbs_[i] = (limbs_[source] << offset) | (offset != 0 && source > 0 ? limbs_[source - 1] >> (64 - offset) : 0);
+    }
+    std::fill_n(limbs_.begin(), limbs, 0);
+    return trim();
+}
+template <class Allocator>
+auto BigInteger<Allocator>::operator>>=(int bits) -> BigInteger&
+{
+    const auto limbs = static_cast<std::size_t>(bits / 64);
+    const auto offset = bits % 64;
+    if (limbs >= limbs_.size()) {
+        limbs_.clear();
+        return trim();
+    }
+    for (std::size_t i = 0; i + limbs < limbs_.size(); ++i) {
+        const auto source = i + limbs;
+        limbs_[i] = (limbs_[source] >> offset) | (offset != 0 && source + 1 < limbs_.size() ? limbs_[source + 1] << (64 - offset) : 0);
+    }
+    limbs_.resize(limbs_.size() - limbs);
+    return trim();
+}
+
+template <class Allocator>
+auto BigInteger<Allocator>::combine(std::int64_t lhs_coeff, const BigInteger& lhs, std::int64_t rhs_coeff, const BigInteger& rhs) -> BigInteger
+{
+    BigInteger result{lhs, lhs.get_allocator()}, other{rhs, lhs.get_allocator()};
+    result *= magnitude(lhs_coeff);
+    other *= magnitude(rhs_coeff);
+    if (lhs_coeff < 0) {
+        result.negate();
+    }
+    if (rhs_coeff < 0) {
+        other.negate();
+    }
+    return result += other;
+}
+// Lehmer's algorithm (Knuth's Algorithm L) on the leading 62 bits, then a single-limb binary GCD
+template <class Allocator>
+auto BigInteger<Allocator>::gcd(BigInteger lhs, BigInteger rhs) -> BigInteger
+{
+    lhs.abs();
+    rhs.abs();
+    if (compare_magnitude(lhs, rhs) < 0) {
+        std::swap(lhs, rhs);
+    }
+
+    while (rhs.limbs_.size() > 1) {
+        const auto shift = lhs.bit_width() - 62;
+        int128_t x = lhs.top_bits(shift), y = rhs.top_bits(shift);
+        int128_t a = 1, b = 0, c = 0, d = 1;
+        while (y + c != 0 && y + d != 0) {
+            const auto quotient = (x + a) / (y + c);
+            if (quotient != (x + b) / (y + d)) {
+                break;
+            }
+            auto tmp = a - quotient * c;
+            a = c;
+            c = tmp;
+            tmp = b - quotient * d;
+            b = d;
+            d = tmp;
+            tmp = x - quotient * y;
+            x = y;
+            y = tmp;
+        }
+
+        if (b == 0) {
+            BigInteger quotient{lhs.get_allocator()}, remainder{lhs.get_allocator()};
+            divide(lhs, rhs, quotient, remainder);
+            lhs = std::move(rhs);
+            rhs = std::move(remainder);
+        } else {
+            auto next_lhs = combine(static_cast<std::int64_t>(a), lhs, static_cast<std::int64_t>(b), rhs);
+            auto next_rhs = combine(static_cast<std::int64_t>(c), lhs, static_cast<std::int64_t>(d), rhs);
+            lhs = std::move(next_lhs.abs());
+            rhs = std::move(next_rhs.abs());
+        }
+        if (compare_magnitude(lhs, rhs) < 0) {
+            std::swap(lhs, rhs);
+        }
+    }
+
+    if (rhs.is_zero()) {
+        return lhs;
+    }
+    const auto rest = divide_small(lhs.limbs_, rhs.limbs_[0]);
+    return BigInteger{false, binary_gcd(rhs.limbs_[0], rest), lhs.get_allocator()};
+}
+
+template <class Allocator>
+bool operator==(const BigInteger<Allocator>& lhs, const BigInteger<Allocator>& rhs) noexcept
+{
+    return lhs.negative() == rhs.negative() && lhs.limbs() == rhs.limbs();
+}
+template <class Allocator>
+std::strong_ordering operator<=>(const BigInteger<Allocator>& lhs, const BigInteger<Allocator>& rhs) noexcept
+{
+    if (lhs.negative() != rhs.negative()) {
+        return lhs.negative() ? std::strong_ordering::less : std::strong_ordering::greater;
+    }
+    const auto order = BigInteger<Allocator>::compare_magnitude(lhs, rhs);
+    return (lhs.negative() ? -order : order) <=> 0;
+}
+
+template <class Allocator>
+BigInteger<Allocator> operator+(const BigInteger<Allocator>& lhs, const BigInteger<Allocator>& rhs)
+{
+    return BigInteger<Allocator>{lhs, lhs.get_allocator()} += rhs;
+}
+template <class Allocator>
+BigInteger<Allocator> operator-(const BigInteger<Allocator>& lhs, const BigInteger<Allocator>& rhs)
+{
+    return BigInteger<Allocator>{lhs, lhs.get_allocator()} -= rhs;
+}
+template <class Allocator>
+BigInteger<Allocator> operator*(const BigInteger<Allocator>& lhs, const BigInteger<Allocator>& rhs)
+{
+    return BigInteger<Allocator>{lhs, lhs.get_allocator()} *= rhs;
+}
+template <class Allocator>
+BigInteger<Allocator> operator/(const BigInteger<Allocator>& lhs, const BigInteger<Allocator>& rhs)
+{
+    return BigInteger<Allocator>{lhs, lhs.get_allocator()} /= rhs;
+}
+template <class Allocator>
+BigInteger<Allocator> operator%(const BigInteger<Allocator>& lhs, const BigInteger<Allocator>& rhs)
+{
+    return BigInteger<Allocator>{lhs, lhs.get_allocator()} %= rhs;
+}
+}  // namespace rational::detail
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "big_integer.hpp"
+#include "rational.hpp"
+
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+
+template <class Allocator = std::allocator<std::uint64_t>>
+struct BasicBigRational {
+    using IntegerType = rational::detail::BigInteger<Allocator>;
+    using SmallType = Rational<std::int64_t>;
+    using allocator_type = Allocator;
+
+    explicit BasicBigRational(const Allocator& = Allocator{});
+    explicit BasicBigRational(std::int64_t, std::int64_t = 1, const Allocator& = Allocator{});
+    template <std::signed_integral U>
+    requires(sizeof(U) <= sizeof(std::int64_t)) BasicBigRational(const Rational<U>&, const Allocator& = Allocator{});
+    BasicBigRational(const BasicBigRational&, const Allocator&);
+    // Reduced to lowest terms, with the allocator of numer
+    BasicBigRational(IntegerType numer, IntegerType denom);
+
+    BasicBigRational(const BasicBigRational&) = default;
+    BasicBigRational(BasicBigRational&&) noexcept = default;
+    BasicBigRational& operator=(const BasicBigRational&) = default;
+    BasicBigRational& operator=(BasicBigRational&&) noexcept = default;
+
+    allocator_type get_allocator() const noexcept { return numer_.get_allocator(); }
+    bool is_inline() const noexcept { return !big_; }
+    IntegerType numer() const;
+    IntegerType denom() const;
+
+    template <std::signed_integral U>
+    explicit operator Rational<U>() const noexcept(rational::nothrow_overflow_v<U>);
+    template <std::floating_point U>
+    explicit operator U() const noexcept;
+
+    BasicBigRational operator+() const;
+    BasicBigRational operator-() const;
+    BasicBigRational inverse() const;
+
+    BasicBigRational& operator+=(const BasicBigRational&);
+    BasicBigRational& operator-=(const BasicBigRational&);
+    BasicBigRational& operator*=(const BasicBigRational&);
+    BasicBigRational& operator/=(const BasicBigRational&);
+
+    template <std::signed_integral U>
+    BasicBigRational& operator+=(U);
+    template <std::signed_integral U>
+    BasicBigRational& operator-=(U);
+    template <std::signed_integral U>
+    BasicBigRational& operator*=(U);
+    template <std::signed_integral U>
+    BasicBigRational& operator/=(U);
+
+private:
+    template <class OtherAllocator>
+    friend bool operator==(const BasicBigRational<OtherAllocator>&, const BasicBigRational<OtherAllocator>&);
+    template <class OtherAllocator>
+    friend std::strong_ordering operator<=>(const BasicBigRational<OtherAllocator>&, const BasicBigRational<OtherAllocator>&);
+    friend struct std::hash<BasicBigRational>;
+
+    SmallType small_;
+    IntegerType numer_;
+    IntegerType denom_;
+    bool big_;
+
+    BasicBigRational& assign(const rational::detail::WideFraction<std::int64_t>&);
+    BasicBigRational& assign(IntegerType numer, IntegerType denom);
+    BasicBigRational& promote();
+};
+
+using BigRational = BasicBigRational<>;
+
+namespace rational::pmr
+{
+using BigRational = BasicBigRational<std::pmr::polymorphic_allocator<std::uint64_t>>;
+}  // namespace rational::pmr
+
+template <class Allocator>
+bool operator==(const BasicBigRational<Allocator>&, const BasicBigRational<Allocator>&);
+template <class Allocator, std::signed_integral U>
+bool operator==(const BasicBigRational<Allocator>&, const Rational<U>&);
+template <class Allocator, std::signed_integral U>
+bool operator==(const BasicBigRational<Allocator>&, U);
+
+template <class Allocator>
+std::strong_ordering operator<=>(const BasicBigRational<Allocator>&, const BasicBigRational<Allocator>&);
+template <class Allocator, std::signed_integral U>
+std::strong_ordering operator<=>(const BasicBigRational<Allocator>&, const Rational<U>&);
+template <class Allocator, std::signed_integral U>
+std::strong_ordering operator<=>(const BasicBigRational<Allocator>&, U);
+
+template <class Allocator>
+BasicBigRational<Allocator> operator+(const BasicBigRational<Allocator>&, const BasicBigRational<Allocator>&);
+template <class Allocator>
+BasicBigRational<Allocator> operator-(const BasicBigRational<Allocator>&, const BasicBigRational<Allocator>&);
+template <class Allocator>
+BasicBigRational<Allocator> operator*(const BasicBigRational<Allocator>&, const BasicBigRational<Allocator>&);
+template <class Allocator>
+BasicBigRational<Allocator> operator/(const BasicBigRational<Allocator>&, const BasicBigRational<Allocator>&);
+
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator+(const BasicBigRational<Allocator>&, const Rational<U>&);
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator-(const BasicBigRational<Allocator>&, const Rational<U>&);
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator*(const BasicBigRational<Allocator>&, const Rational<U>&);
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator/(const BasicBigRational<Allocator>&, const Rational<U>&);
+
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator+(const Rational<U>&, const BasicBigRational<Allocator>&);
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator-(const Rational<U>&, const BasicBigRational<Allocator>&);
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator*(const Rational<U>&, const BasicBigRational<Allocator>&);
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator/(const Rational<U>&, const BasicBigRational<Allocator>&);
+
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator+(const BasicBigRational<Allocator>&, U);
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator-(const BasicBigRational<Allocator>&, U);
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator*(const BasicBigRational<Allocator>&, U);
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator/(const BasicBigRational<Allocator>&, U);
+
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator+(U, const BasicBigRational<Allocator>&);
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator-(U, const BasicBigRational<Allocator>&);
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator*(U, const BasicBigRational<Allocator>&);
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator/(U, const BasicBigRational<Allocator>&);
+
+template <class Allocator>
+struct std::hash<BasicBigRational<Allocator>> {
+    std::size_t operator()(const BasicBigRational<Allocator>&) const noexcept;
+};
+
+#include "big_rational.ipp"
@@ -0,0 +1,526 @@
+#pragma once
+
+#include "big_integer.hpp"
+#include "big_rational.hpp"
+#include "rational_gcd.hpp"
+#include "rational_wide.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace rational::detail
+{
+template <class Allocator>
+BigInteger<Allocator> divide_exact(const BigInteger<Allocator>& value, const BigInteger<Allocator>& divisor)
+{
+    return divisor.bit_width() == 1 ? value : value / divisor;
+}
+
+// Knuth's 4.5.1 sum, with both operands in lowest terms
+template <class Allocator>
+void big_sum(BigInteger<Allocator>& numer, BigInteger<Allocator>& denom, const BigInteger<Allocator>& other_numer, const BigInteger<Allocator>& other_denom, bool subtract)
+{
+    using Integer = BigInteger<Allocator>;
+
+    const auto gcd = Integer::gcd(denom, other_denom);
+    const auto lhs_coeff = divide_exact(denom, gcd), rhs_coeff = divide_exact(other_denom, gcd);
+    auto term = numer * rhs_coeff;
+    if (subtract) {
+        term -= other_numer * lhs_coeff;
+    } else {
+        term += other_numer * lhs_coeff;
+    }
+    const auto common = gcd.bit_width() == 1 ? gcd : Integer::gcd(term, gcd);
+    numer = divide_exact(term, common);
+    denom = lhs_coeff * divide_exact(other_denom, common);
+}
+template <class Allocator>
+void big_product(BigInteger<Allocator>& numer, BigInteger<Allocator>& denom, const BigInteger<Allocator>& other_numer, const BigInteger<Allocator>& other_denom)
+{
+    using Integer = BigInteger<Allocator>;
+
+    const auto lhs_gcd = Integer::gcd(numer, other_denom), rhs_gcd = Integer::gcd(other_numer, denom);
+    numer = divide_exact(numer, lhs_gcd) * divide_exact(other_numer, rhs_gcd);
+    denom = divide_exact(denom, rhs_gcd) * divide_exact(other_denom, lhs_gcd);
+}
+}  // namespace rational::detail
+
+template <class Allocator>
+BasicBigRational<Allocator>::BasicBigRational(const Allocator& allocator)
+    : small_{0}, numer_{allocator}, denom_{allocator}, big_{false}
+{
+}
+template <class Allocator>
+BasicBigRational<Allocator>::BasicBigRational(std::int64_t numer, std::int64_t denom, const Allocator& allocator)
+    : small_{0}, numer_{allocator}, denom_{allocator}, big_{false}
+{
+    using rational::detail::magnitude;
+    if (denom == 0) {
+        throw std::range_error{"0 is given as denom of Rational"};
+    }
+    // on magnitudes, so that min / -1 becomes 2^63 instead of wrapping
+    const auto gcd = rational::detail::binary_gcd(magnitude(numer), magnitude(denom));
+    assign(rational::detail::WideFraction<std::int64_t>{(numer < 0) != (denom < 0), magnitude(numer) / gcd, magnitude(denom) / gcd});
+}
+template <class Allocator>
+template <std::signed_integral U>
+requires(sizeof(U) <= sizeof(std::int64_t)) BasicBigRational<Allocator>::BasicBigRational(const Rational<U>& value, const Allocator& allocator)
+    : small_{value}, numer_{allocator}, denom_{allocator}, big_{false}
+{
+}
+template <class Allocator>
+BasicBigRational<Allocator>::BasicBigRational(const BasicBigRational& other, const Allocator& allocator)
+    : small_{other.small_}, numer_{other.numer_, allocator}, denom_{other.denom_, allocator}, big_{other.big_}
+{
+}
+
+template <class Allocator>
+BasicBigRational<Allocator>::BasicBigRational(IntegerType numer, IntegerType denom)
+    : small_{0}, numer_{numer.get_allocator()}, denom_{numer.get_allocator()}, big_{false}
+{
+    if (denom.is_zero()) {
+        throw std::range_error{"0 is given as denom of Rational"};
+    }
+    if (denom.negative()) {
+        numer.negate();
+        denom.negate();
+    }
+    const auto gcd = IntegerType::gcd(numer, denom);
+    assign(numer / gcd, denom / gcd);
+}
+
+template <class Allocator>
+auto BasicBigRational<Allocator>::numer() const -> IntegerType
+{
+    if (big_) {
+        return numer_;
+    }
+    return IntegerType{small_.numer() < 0, rational::detail::magnitude(small_.numer()), get_allocator()};
+}
+template <class Allocator>
+auto BasicBigRational<Allocator>::denom() const -> IntegerType
+{
+    if (big_) {
+        return denom_;
+    }
+    return IntegerType{false, small_.denom(), get_allocator()};
+}
+
+template <class Allocator>
+auto BasicBigRational<Allocator>::assign(const rational::detail::WideFraction<std::int64_t>& value) -> BasicBigRational&
+{
+    if (rational::detail::fits(value)) {
+        small_ = SmallType{SmallType::simple_copy_,
+            rational::detail::with_sign<std::int64_t>(value.negative && value.numer != 0, static_cast<std::uint64_t>(value.numer)),
+            static_cast<std::uint64_t>(value.denom)};
+        big_ = false;
+    } else {
+        numer_ = IntegerType{value.negative, value.numer, get_allocator()};
+        denom_ = IntegerType{false, value.denom, get_allocator()};
+        big_ = true;
+    }
+    return *this;
+}
+template <class Allocator>
+auto BasicBigRational<Allocator>::assign(IntegerType numer, IntegerType denom) -> BasicBigRational&
+{
+    if (numer.fits_magnitude(64) && denom.fits_magnitude(64)) {
+        const rational::detail::WideFraction<std::int64_t> value{numer.negative(), numer.low_magnitude(), denom.low_magnitude()};
+        if (rational::detail::fits(value)) {
+            return assign(value);
+        }
+    }
+    numer_ = std::move(numer);
+    denom_ = std::move(denom);
+    big_ = true;
+    return *this;
+}
+template <class Allocator>
+auto BasicBigRational<Allocator>::promote() -> BasicBigRational&
+{
+    if (!big_) {
+        numer_ = numer();
+        denom_ = denom();
+        big_ = true;
+    }
+    return *this;
+}
+
+template <class Allocator>
+template <std::signed_integral U>
+BasicBigRational<Allocator>::operator Rational<U>() const noexcept(rational::nothrow_overflow_v<U>)
+{
+    using rational::detail::uint128_t;
+    using Unsigned = std::make_unsigned_t<U>;
+    using Policy = rational::overflow_policy_t<U>;
+
+    if constexpr (sizeof(U) == sizeof(std::int64_t)) {
+        if (!big_) {
+            return Rational<U>{Rational<U>::simple_copy_, small_.numer(), small_.denom()};
+        }
+    }
+
+    const bool negative = big_ ? numer_.negative() : small_.numer() < 0;
+    const auto numer_width = big_ ? numer_.bit_width() : rational::detail::bit_width(small_.numer());
+    const auto denom_width = big_ ? denom_.bit_width() : static_cast<int>(std::bit_width(small_.denom()));
+    const auto shift = std::max(std::max(numer_width, denom_width) - 128, 0);
+    auto numer = big_ ? (IntegerType{numer_} >>= shift).low_magnitude() : uint128_t{rational::detail::magnitude(small_.numer())};
+    auto denom = big_ ? (IntegerType{denom_} >>= shift).low_magnitude() : uint128_t{small_.denom()};
+
+    const auto numer_limit = static_cast<uint128_t>(std::numeric_limits<U>::max()) + (negative ? 1 : 0);
+    const auto denom_limit = static_cast<uint128_t>(std::numeric_limits<Unsigned>::max());
+    if (shift != 0 || numer > numer_limit || denom > denom_limit) [[unlikely]] {
+        if constexpr (std::is_same_v<Policy, rational::ThrowOnOverflow>) {
+            throw std::overflow_error{"BigRational overflows the Rational type"};
+        } else if constexpr (std::is_same_v<Policy, rational::SaturateOnOverflow>) {
+            if (denom == 0) {
+                denom = 1;
+            }
+            rational::detail::approximate(numer, denom, numer_limit, denom_limit);
+        } else {
+            numer = big_ ? numer_.low_magnitude() : numer;
+            denom = big_ ? denom_.low_magnitude() : denom;
+        }
+    }
+    return Rational<U>{Rational<U>::simple_copy_,
+        rational::detail::with_sign<U>(negative && numer != 0, static_cast<Unsigned>(numer)),
+        static_cast<Unsigned>(denom)};
+}
+template <class Allocator>
+template <std::floating_point U>
+BasicBigRational<Allocator>::operator U() const noexcept
+{
+    if (!big_) {
+        return static_cast<U>(small_);
+    }
+    const auto numer_shift = std::max(numer_.bit_width() - 64, 0);
+    const auto denom_shift = std::max(denom_.bit_width() - 64, 0);
+    const auto value = std::ldexp(static_cast<U>(numer_.top_bits(numer_shift)) / static_cast<U>(denom_.top_bits(denom_shift)), numer_shift - denom_shift);
+    return numer_.negative() ? -value : value;
+}
+
+template <class Allocator>
+auto BasicBigRational<Allocator>::operator+() const -> BasicBigRational
+{
+    return BasicBigRational{*this, get_allocator()};
+}
+template <class Allocator>
+auto BasicBigRational<Allocator>::operator-() const -> BasicBigRational
+{
+    BasicBigRational result{*this, get_allocator()};
+    if (!big_) {
+        result.assign({small_.numer() > 0, rational::detail::magnitude(small_.numer()), small_.denom()});
+        return result;
+    }
+    result.numer_.negate();
+    result.assign(std::move(result.numer_), std::move(result.denom_));
+    return result;
+}
+template <class Allocator>
+auto BasicBigRational<Allocator>::inverse() const -> BasicBigRational
+{
+    BasicBigRational result{*this, get_allocator()};
+    if (!big_) {
+        if (small_.numer() == 0) {
+            throw std::range_error{"0 is given as denom of Rational"};
+        }
+        result.assign({small_.numer() < 0, small_.denom(), rational::detail::magnitude(small_.numer())});
+        return result;
+    }
+    if (numer_.negative()) {
+        result.denom_.negate();
+    }
+    result.assign(std::move(result.denom_), std::move(result.numer_.abs()));
+    return result;
+}
+
+template <class Allocator>
+auto BasicBigRational<Allocator>::operator+=(const BasicBigRational& other) -> BasicBigRational&
+{
+    if (!big_ && !other.big_) {
+        return assign(rational::detail::wide_sum(small_.numer(), small_.denom(), other.small_.numer(), other.small_.denom()));
+    }
+    if (!other.big_) {
+        return *this += BasicBigRational{other, get_allocator()}.promote();
+    }
+    promote();
+    rational::detail::big_sum(numer_, denom_, other.numer_, other.denom_, false);
+    return assign(std::move(numer_), std::move(denom_));
+}
+template <class Allocator>
+auto BasicBigRational<Allocator>::operator-=(const BasicBigRational& other) -> BasicBigRational&
+{
+    if (!big_ && !other.big_) {
+        return assign(rational::detail::wide_sum(small_.numer(), small_.denom(), other.small_.numer(), other.small_.denom(), true));
+    }
+    if (!other.big_) {
+        return *this -= BasicBigRational{other, get_allocator()}.promote();
+    }
+    promote();
+    rational::detail::big_sum(numer_, denom_, other.numer_, other.denom_, true);
+    return assign(std::move(numer_), std::move(denom_));
+}
+template <class Allocator>
+auto BasicBigRational<Allocator>::operator*=(const BasicBigRational& other) -> BasicBigRational&
+{
+    if (!big_ && !other.big_) {
+        return assign(rational::detail::wide_product(small_.numer(), small_.denom(), other.small_.numer(), other.small_.denom()));
+    }
+    if (!other.big_) {
+        return *this *= BasicBigRational{other, get_allocator()}.promote();
+    }
+    promote();
+    rational::detail::big_product(numer_, denom_, other.numer_, other.denom_);
+    return assign(std::move(numer_), std::move(denom_));
+}
+template <class Allocator>
+auto BasicBigRational<Allocator>::operator/=(const BasicBigRational& other) -> BasicBigRational&
+{
+    if (!big_ && !other.big_) {
+        if (other.small_.numer() == 0) {
+            throw std::range_error{"0 is given as denom of Rational"};
+        }
+        return assign(rational::detail::wide_quotient(small_.numer(), small_.denom(), other.small_.numer(), other.small_.denom()));
+    }
+    return *this *= other.inverse();
+}
+
+template <class Allocator>
+template <std::signed_integral U>
+auto BasicBigRational<Allocator>::operator+=(U other) -> BasicBigRational&
+{
+    if (!big_) {
+        return assign(rational::detail::wide_sum(small_.numer(), small_.denom(), static_cast<std::int64_t>(other)));
+    }
+    return *this += BasicBigRational{other, 1, get_allocator()};
+}
+template <class Allocator>
+template <std::signed_integral U>
+auto BasicBigRational<Allocator>::operator-=(U other) -> BasicBigRational&
+{
+    if (!big_) {
+        return assign(rational::detail::wide_sum(small_.numer(), small_.denom(), static_cast<std::int64_t>(other), true));
+    }
+    return *this -= BasicBigRational{other, 1, get_allocator()};
+}
+template <class Allocator>
+template <std::signed_integral U>
+auto BasicBigRational<Allocator>::operator*=(U other) -> BasicBigRational&
+{
+    if (!big_) {
+        return assign(rational::detail::wide_product(small_.numer(), small_.denom(), static_cast<std::int64_t>(other)));
+    }
+    return *this *= BasicBigRational{other, 1, get_allocator()};
+}
+template <class Allocator>
+template <std::signed_integral U>
+auto BasicBigRational<Allocator>::operator/=(U other) -> BasicBigRational&
+{
+    if (other == 0) {
+        throw std::range_error{"0 is given as denom of Rational"};
+    }
+    if (!big_) {
+        return assign(rational::detail::wide_quotient(small_.numer(), small_.denom(), static_cast<std::int64_t>(other)));
+    }
+    return *this /= BasicBigRational{other, 1, get_allocator()};
+}
+
+template <class Allocator>
+bool operator==(const BasicBigRational<Allocator>& lhs, const BasicBigRational<Allocator>& rhs)
+{
+    if (lhs.big_ != rhs.big_) {
+        return false;
+    }
+    if (!lhs.big_) {
+        return lhs.small_ == rhs.small_;
+    }
+    return lhs.numer_ == rhs.numer_ && lhs.denom_ == rhs.denom_;
+}
+template <class Allocator, std::signed_integral U>
+bool operator==(const BasicBigRational<Allocator>& lhs, const Rational<U>& rhs)
+{
+    return lhs == BasicBigRational<Allocator>{rhs, lhs.get_allocator()};
+}
+template <class Allocator, std::signed_integral U>
+bool operator==(const BasicBigRational<Allocator>& lhs, U rhs)
+{
+    return lhs == BasicBigRational<Allocator>{rhs, 1, lhs.get_allocator()};
+}
+
+template <class Allocator>
+std::strong_ordering operator<=>(const BasicBigRational<Allocator>& lhs, const BasicBigRational<Allocator>& rhs)
+{
+    if (!lhs.big_ && !rhs.big_) {
+        return lhs.small_ <=> rhs.small_;
+    }
+    return lhs.numer() * rhs.denom() <=> rhs.numer() * lhs.denom();
+}
+template <class Allocator, std::signed_integral U>
+std::strong_ordering operator<=>(const BasicBigRational<Allocator>& lhs, const Rational<U>& rhs)
+{
+    return lhs <=> BasicBigRational<Allocator>{rhs, lhs.get_allocator()};
+}
+template <class Allocator, std::signed_integral U>
+std::strong_ordering operator<=>(const BasicBigRational<Allocator>& lhs, U rhs)
+{
+    return lhs <=> BasicBigRational<Allocator>{rhs, 1, lhs.get_allocator()};
+}
+
+template <class Allocator>
+BasicBigRational<Allocator> operator+(const BasicBigRational<Allocator>& lhs, const BasicBigRational<Allocator>& rhs)
+{
+    BasicBigRational<Allocator> result{lhs, lhs.get_allocator()};
+    result += rhs;
+    return result;
+}
+template <class Allocator>
+BasicBigRational<Allocator> operator-(const BasicBigRational<Allocator>& lhs, const BasicBigRational<Allocator>& rhs)
+{
+    BasicBigRational<Allocator> result{lhs, lhs.get_allocator()};
+    result -= rhs;
+    return result;
+}
+template <class Allocator>
+BasicBigRational<Allocator> operator*(const BasicBigRational<Allocator>& lhs, const BasicBigRational<Allocator>& rhs)
+{
+    BasicBigRational<Allocator> result{lhs, lhs.get_allocator()};
+    result *= rhs;
+    return result;
+}
+template <class Allocator>
+BasicBigRational<Allocator> operator/(const BasicBigRational<Allocator>& lhs, const BasicBigRational<Allocator>& rhs)
+{
+    BasicBigRational<Allocator> result{lhs, lhs.get_allocator()};
+    result /= rhs;
+    return result;
+}
+
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator+(const BasicBigRational<Allocator>& lhs, const Rational<U>& rhs)
+{
+    BasicBigRational<Allocator> result{lhs, lhs.get_allocator()};
+    result += BasicBigRational<Allocator>{rhs, lhs.get_allocator()};
+    return result;
+}
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator-(const BasicBigRational<Allocator>& lhs, const Rational<U>& rhs)
+{
+    BasicBigRational<Allocator> result{lhs, lhs.get_allocator()};
+    result -= BasicBigRational<Allocator>{rhs, lhs.get_allocator()};
+    return result;
+}
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator*(const BasicBigRational<Allocator>& lhs, const Rational<U>& rhs)
+{
+    BasicBigRational<Allocator> result{lhs, lhs.get_allocator()};
+    result *= BasicBigRational<Allocator>{rhs, lhs.get_allocator()};
+    return result;
+}
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator/(const BasicBigRational<Allocator>& lhs, const Rational<U>& rhs)
+{
+    BasicBigRational<Allocator> result{lhs, lhs.get_allocator()};
+    result /= BasicBigRational<Allocator>{rhs, lhs.get_allocator()};
+    return result;
+}
+
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator+(const Rational<U>& lhs, const BasicBigRational<Allocator>& rhs)
+{
+    BasicBigRational<Allocator> result{lhs, rhs.get_allocator()};
+    result += rhs;
+    return result;
+}
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator-(const Rational<U>& lhs, const BasicBigRational<Allocator>& rhs)
+{
+    BasicBigRational<Allocator> result{lhs, rhs.get_allocator()};
+    result -= rhs;
+    return result;
+}
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator*(const Rational<U>& lhs, const BasicBigRational<Allocator>& rhs)
+{
+    BasicBigRational<Allocator> result{lhs, rhs.get_allocator()};
+    result *= rhs;
+    return result;
+}
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator/(const Rational<U>& lhs, const BasicBigRational<Allocator>& rhs)
+{
+    BasicBigRational<Allocator> result{lhs, rhs.get_allocator()};
+    result /= rhs;
+    return result;
+}
+
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator+(const BasicBigRational<Allocator>& lhs, U rhs)
+{
+    BasicBigRational<Allocator> result{lhs, lhs.get_allocator()};
+    result += rhs;
+    return result;
+}
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator-(const BasicBigRational<Allocator>& lhs, U rhs)
+{
+    BasicBigRational<Allocator> result{lhs, lhs.get_allocator()};
+    result -= rhs;
+    return result;
+}
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator*(const BasicBigRational<Allocator>& lhs, U rhs)
+{
+    BasicBigRational<Allocator> result{lhs, lhs.get_allocator()};
+    result *= rhs;
+    return result;
+}
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator/(const BasicBigRational<Allocator>& lhs, U rhs)
+{
+    BasicBigRational<Allocator> result{lhs, lhs.get_allocator()};
+    result /= rhs;
+    return result;
+}
+
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator+(U lhs, const BasicBigRational<Allocator>& rhs)
+{
+    return rhs + lhs;
+}
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator-(U lhs, const BasicBigRational<Allocator>& rhs)
+{
+    return lhs + (-rhs);
+}
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator*(U lhs, const BasicBigRational<Allocator>& rhs)
+{
+    return rhs * lhs;
+}
+template <class Allocator, std::signed_integral U>
+BasicBigRational<Allocator> operator/(U lhs, const BasicBigRational<Allocator>& rhs)
+{
+    return lhs * rhs.inverse();
+}
+
+template <class Allocator>
+std::size_t std::hash<BasicBigRational<Allocator>>::operator()(const BasicBigRational<Allocator>& value) const noexcept
+{
+    if (!value.big_) {
+        return std::hash<Rational<std::int64_t>>{}(value.small_);
+    }
+    std::size_t result = value.numer_.negative() ? 1 : 0;
+    for (const auto& integer : {&value.numer_, &value.denom_}) {
+        for (const auto limb : integer->limbs()) {
+            const auto hash = std::hash<std::uint64_t>{}(limb);
+            result ^= hash + 0x9e3779b97f4a7c15 + (result << 6) + (result >> 2);
+        }
+    }
+    return result;
+}
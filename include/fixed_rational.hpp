@@ -0,0 +1,120 @@
+#pragma once
+
+#include "rational.hpp"
+
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <ratio>
+#include <type_traits>
+
+namespace rational
+{
+// std::ratio<1, D> with D representable as the denominator of Rational<T>
+template <class Scale, class T>
+concept fixed_scale = std::signed_integral<T> && std::is_same_v<Scale, std::ratio<Scale::num, Scale::den>> && Scale::num == 1
+                      && static_cast<std::uintmax_t>(Scale::den) <= std::numeric_limits<std::make_unsigned_t<T>>::max();
+
+// an integer that converts to T without narrowing, so int literals mix with any FixedRational they fit
+template <class U, class T>
+concept fixed_operand = std::integral<U> && !std::same_as<U, bool> && requires(U value) { T{value}; };
+}  // namespace rational
+
+// numer() / Scale::den, with the denominator in the type: no GCD, and the size of T.
+// Results that fall between two steps are rounded to nearest, ties to even
+template <std::signed_integral T, rational::fixed_scale<T> Scale>
+struct FixedRational {
+    using NumeratorType = T;
+    using DenominatorType = std::make_unsigned_t<T>;
+    using ScaleType = Scale;
+
+    explicit constexpr FixedRational(NumeratorType = 0) noexcept(rational::nothrow_overflow_v<T>);
+    explicit constexpr FixedRational(const Rational<T>&) noexcept(rational::nothrow_overflow_v<T>);
+    constexpr static FixedRational from_numer(NumeratorType numer) noexcept { return FixedRational{simple_copy_, numer}; }
+
+    constexpr FixedRational(const FixedRational&) noexcept = default;
+    constexpr FixedRational(FixedRational&&) noexcept = default;
+    constexpr FixedRational& operator=(const FixedRational&) noexcept = default;
+    constexpr FixedRational& operator=(FixedRational&&) noexcept = default;
+
+    constexpr NumeratorType numer() const noexcept { return numer_; }
+    constexpr static DenominatorType denom() noexcept { return denom_; }
+
+    constexpr operator Rational<T>() const noexcept { return Rational<T>{numer_, denom_}; }
+    constexpr double to_double() const noexcept { return rational::detail::to_floating<double>(numer_, denom_); }
+    constexpr float to_float() const noexcept { return rational::detail::to_floating<float>(numer_, denom_); }
+
+    template <class U>
+    explicit constexpr operator U() const noexcept;
+
+    constexpr FixedRational operator+() const noexcept;
+    constexpr FixedRational operator-() const noexcept(rational::nothrow_overflow_v<T>);
+
+    constexpr FixedRational& operator+=(const FixedRational&) noexcept(rational::nothrow_overflow_v<T>);
+    constexpr FixedRational& operator-=(const FixedRational&) noexcept(rational::nothrow_overflow_v<T>);
+    constexpr FixedRational& operator*=(const FixedRational&) noexcept(rational::nothrow_overflow_v<T>);
+    constexpr FixedRational& operator/=(const FixedRational&);
+
+    constexpr FixedRational& operator+=(T) noexcept(rational::nothrow_overflow_v<T>);
+    constexpr FixedRational& operator-=(T) noexcept(rational::nothrow_overflow_v<T>);
+    constexpr FixedRational& operator*=(T) noexcept(rational::nothrow_overflow_v<T>);
+    constexpr FixedRational& operator/=(T);
+
+private:
+    NumeratorType numer_;
+
+    constexpr static auto denom_ = static_cast<DenominatorType>(Scale::den);
+
+    using SimpleCopy = decltype(std::placeholders::_1);
+    constexpr static SimpleCopy simple_copy_{};
+    explicit constexpr FixedRational(SimpleCopy, NumeratorType numer) noexcept : numer_{numer} {}
+};
+
+template <std::signed_integral T, class Scale>
+constexpr bool operator==(const FixedRational<T, Scale>&, const FixedRational<T, Scale>&) noexcept;
+template <std::signed_integral T, class Scale>
+constexpr bool operator==(const FixedRational<T, Scale>&, const Rational<T>&) noexcept;
+template <std::signed_integral T, class Scale>
+constexpr bool operator!=(const FixedRational<T, Scale>&, const FixedRational<T, Scale>&) noexcept;
+template <std::signed_integral T, class Scale>
+constexpr bool operator!=(const FixedRational<T, Scale>&, const Rational<T>&) noexcept;
+
+template <std::signed_integral T, class Scale>
+constexpr std::strong_ordering operator<=>(const FixedRational<T, Scale>&, const FixedRational<T, Scale>&) noexcept;
+
+template <std::signed_integral T, class Scale>
+constexpr FixedRational<T, Scale> operator+(const FixedRational<T, Scale>&, const FixedRational<T, Scale>&) noexcept(rational::nothrow_overflow_v<T>);
+template <std::signed_integral T, class Scale>
+constexpr FixedRational<T, Scale> operator-(const FixedRational<T, Scale>&, const FixedRational<T, Scale>&) noexcept(rational::nothrow_overflow_v<T>);
+template <std::signed_integral T, class Scale>
+constexpr FixedRational<T, Scale> operator*(const FixedRational<T, Scale>&, const FixedRational<T, Scale>&) noexcept(rational::nothrow_overflow_v<T>);
+template <std::signed_integral T, class Scale>
+constexpr FixedRational<T, Scale> operator/(const FixedRational<T, Scale>&, const FixedRational<T, Scale>&);
+
+template <std::signed_integral T, class Scale, rational::fixed_operand<T> U>
+constexpr FixedRational<T, Scale> operator+(const FixedRational<T, Scale>&, U) noexcept(rational::nothrow_overflow_v<T>);
+template <std::signed_integral T, class Scale, rational::fixed_operand<T> U>
+constexpr FixedRational<T, Scale> operator-(const FixedRational<T, Scale>&, U) noexcept(rational::nothrow_overflow_v<T>);
+template <std::signed_integral T, class Scale, rational::fixed_operand<T> U>
+constexpr FixedRational<T, Scale> operator*(const FixedRational<T, Scale>&, U) noexcept(rational::nothrow_overflow_v<T>);
+template <std::signed_integral T, class Scale, rational::fixed_operand<T> U>
+constexpr FixedRational<T, Scale> operator/(const FixedRational<T, Scale>&, U);
+
+// The integer on the left of - and / is converted to FixedRational first, so it has to fit one
+template <std::signed_integral T, class Scale, rational::fixed_operand<T> U>
+constexpr FixedRational<T, Scale> operator+(U, const FixedRational<T, Scale>&) noexcept(rational::nothrow_overflow_v<T>);
+template <std::signed_integral T, class Scale, rational::fixed_operand<T> U>
+constexpr FixedRational<T, Scale> operator-(U, const FixedRational<T, Scale>&) noexcept(rational::nothrow_overflow_v<T>);
+template <std::signed_integral T, class Scale, rational::fixed_operand<T> U>
+constexpr FixedRational<T, Scale> operator*(U, const FixedRational<T, Scale>&) noexcept(rational::nothrow_overflow_v<T>);
+template <std::signed_integral T, class Scale, rational::fixed_operand<T> U>
+constexpr FixedRational<T, Scale> operator/(U, const FixedRational<T, Scale>&);
+
+template <std::signed_integral T, class Scale>
+struct std::hash<FixedRational<T, Scale>> {
+    std::size_t operator()(const FixedRational<T, Scale>&) const noexcept;
+};
+
+#include "fixed_rational.ipp"
@@ -0,0 +1,263 @@
+#pragma once
+
+#include "fixed_rational.hpp"
+#include "rational_floating.hpp"
+#include "rational_gcd.hpp"
+#include "rational_wide.hpp"
+
+#include <compare>
+#include <concepts>
+#include <limits>
+#include <stdexcept>
+
+namespace rational::detail
+{
+// Every step keeps to the wide type, so the policy is applied to the exact result only once
+template <std::signed_integral T>
+constexpr T narrow_scaled(wide_signed_t<T> value) noexcept(nothrow_overflow_v<T>)
+{
+    using Wide = wide_signed_t<T>;
+    using Policy = overflow_policy_t<T>;
+    constexpr auto min = static_cast<Wide>(std::numeric_limits<T>::min()), max = static_cast<Wide>(std::numeric_limits<T>::max());
+
+    if constexpr (std::is_same_v<Policy, SaturateOnOverflow>) {
+        // clamped rather than approximated as narrow does for Rational: with the denominator fixed, the bound is the closest value
+        return static_cast<T>(value < min ? min : value > max ? max : value);
+    } else if constexpr (std::is_same_v<Policy, ThrowOnOverflow>) {
+        if (value < min || value > max) [[unlikely]] {
+            throw std::overflow_error{"result of FixedRational arithmetic overflows"};
+        }
+    }
+    return static_cast<T>(value);
+}
+template <std::signed_integral T>
+constexpr wide_signed_t<T> scaled_with_sign(bool negative, wide_unsigned_t<T> magnitude) noexcept
+{
+    return static_cast<wide_signed_t<T>>(negative ? static_cast<wide_unsigned_t<T>>(0 - magnitude) : magnitude);
+}
+
+// quotient of value / divisor rounded to nearest, ties to even
+template <unsigned_word W, class U>
+constexpr W round_to_even(W value, W quotient, U divisor) noexcept
+{
+    const auto rest = static_cast<W>(value - quotient * divisor);
+    const auto other = static_cast<W>(divisor - rest);
+    return static_cast<W>(rest > other || (rest == other && (quotient & 1) != 0) ? quotient + 1 : quotient);
+}
+template <unsigned_word W, std::unsigned_integral U>
+constexpr W rounded_quotient(W value, U divisor) noexcept
+{
+    return round_to_even(value, quotient(value, divisor), divisor);
+}
+template <auto Divisor, unsigned_word W>
+constexpr W rounded_quotient_by(W value) noexcept
+{
+    return round_to_even(value, quotient_by<Divisor>(value), Divisor);
+}
+}  // namespace rational::detail
+
+template <std::signed_integral T, rational::fixed_scale<T> Scale>
+constexpr FixedRational<T, Scale>::FixedRational(NumeratorType value) noexcept(rational::nothrow_overflow_v<T>)
+    : numer_{rational::detail::narrow_scaled<T>(static_cast<rational::detail::wide_signed_t<T>>(rational::detail::wide_signed_t<T>{value} * denom_))}
+{
+}
+template <std::signed_integral T, rational::fixed_scale<T> Scale>
+constexpr FixedRational<T, Scale>::FixedRational(const Rational<T>& value) noexcept(rational::nothrow_overflow_v<T>)
+    : numer_{rational::detail::narrow_scaled<T>(rational::detail::scaled_with_sign<T>(value.numer() < 0,
+        rational::detail::rounded_quotient(static_cast<rational::detail::wide_unsigned_t<T>>(rational::detail::wide_unsigned_t<T>{rational::detail::magnitude(value.numer())} * denom_), value.denom())))}
+{
+}
+
+template <std::signed_integral T, rational::fixed_scale<T> Scale>
+template <class U>
+constexpr FixedRational<T, Scale>::operator U() const noexcept
+{
+    if constexpr (rational::detail::binary_floating<U>) {
+        return rational::detail::to_floating<U>(numer_, denom_);
+    } else {
+        return static_cast<U>(static_cast<Rational<T>>(*this));
+    }
+}
+
+template <std::signed_integral T, rational::fixed_scale<T> Scale>
+constexpr auto FixedRational<T, Scale>::operator+() const noexcept -> FixedRational
+{
+    return *this;
+}
+template <std::signed_integral T, rational::fixed_scale<T> Scale>
+constexpr auto FixedRational<T, Scale>::operator-() const noexcept(rational::nothrow_overflow_v<T>) -> FixedRational
+{
+    using Wide = rational::detail::wide_signed_t<T>;
+    return FixedRational{simple_copy_, rational::detail::narrow_scaled<T>(static_cast<Wide>(-Wide{numer_}))};
+}
+
+template <std::signed_integral T, rational::fixed_scale<T> Scale>
+constexpr auto FixedRational<T, Scale>::operator+=(const FixedRational& other) noexcept(rational::nothrow_overflow_v<T>) -> FixedRational&
+{
+    using Wide = rational::detail::wide_signed_t<T>;
+    numer_ = rational::detail::narrow_scaled<T>(static_cast<Wide>(Wide{numer_} + other.numer_));
+    return *this;
+}
+template <std::signed_integral T, rational::fixed_scale<T> Scale>
+constexpr auto FixedRational<T, Scale>::operator-=(const FixedRational& other) noexcept(rational::nothrow_overflow_v<T>) -> FixedRational&
+{
+    using Wide = rational::detail::wide_signed_t<T>;
+    numer_ = rational::detail::narrow_scaled<T>(static_cast<Wide>(Wide{numer_} - other.numer_));
+    return *this;
+}
+template <std::signed_integral T, rational::fixed_scale<T> Scale>
+constexpr auto FixedRational<T, Scale>::operator*=(const FixedRational& other) noexcept(rational::nothrow_overflow_v<T>) -> FixedRational&
+{
+    using Word = rational::detail::wide_unsigned_t<T>;
+    using rational::detail::magnitude;
+
+    const auto product = static_cast<Word>(Word{magnitude(numer_)} * magnitude(other.numer_));
+    numer_ = rational::detail::narrow_scaled<T>(rational::detail::scaled_with_sign<T>((numer_ < 0) != (other.numer_ < 0),
+        rational::detail::rounded_quotient_by<denom_>(product)));
+    return *this;
+}
+template <std::signed_integral T, rational::fixed_scale<T> Scale>
+constexpr auto FixedRational<T, Scale>::operator/=(const FixedRational& other) -> FixedRational&
+{
+    using Word = rational::detail::wide_unsigned_t<T>;
+    using rational::detail::magnitude;
+
+    if (other.numer_ == 0) {
+        throw std::range_error{"0 is given as denom of Rational"};
+    }
+    const auto scaled = static_cast<Word>(Word{magnitude(numer_)} * denom_);
+    numer_ = rational::detail::narrow_scaled<T>(rational::detail::scaled_with_sign<T>((numer_ < 0) != (other.numer_ < 0),
+        rational::detail::rounded_quotient(scaled, magnitude(other.numer_))));
+    return *this;
+}
+
+template <std::signed_integral T, rational::fixed_scale<T> Scale>
+constexpr auto FixedRational<T, Scale>::operator+=(T other) noexcept(rational::nothrow_overflow_v<T>) -> FixedRational&
+{
+    using Wide = rational::detail::wide_signed_t<T>;
+    numer_ = rational::detail::narrow_scaled<T>(static_cast<Wide>(Wide{other} * denom_ + numer_));
+    return *this;
+}
+template <std::signed_integral T, rational::fixed_scale<T> Scale>
+constexpr auto FixedRational<T, Scale>::operator-=(T other) noexcept(rational::nothrow_overflow_v<T>) -> FixedRational&
+{
+    using Wide = rational::detail::wide_signed_t<T>;
+    numer_ = rational::detail::narrow_scaled<T>(static_cast<Wide>(Wide{numer_} - Wide{other} * denom_));
+    return *this;
+}
+template <std::signed_integral T, rational::fixed_scale<T> Scale>
+constexpr auto FixedRational<T, Scale>::operator*=(T other) noexcept(rational::nothrow_overflow_v<T>) -> FixedRational&
+{
+    using Wide = rational::detail::wide_signed_t<T>;
+    numer_ = rational::detail::narrow_scaled<T>(static_cast<Wide>(Wide{numer_} * other));
+    return *this;
+}
+template <std::signed_integral T, rational::fixed_scale<T> Scale>
+constexpr auto FixedRational<T, Scale>::operator/=(T other) -> FixedRational&
+{
+    using Word = rational::detail::wide_unsigned_t<T>;
+    using rational::detail::magnitude;
+
+    if (other == 0) {
+        throw std::range_error{"0 is given as denom of Rational"};
+    }
+    numer_ = rational::detail::narrow_scaled<T>(rational::detail::scaled_with_sign<T>((numer_ < 0) != (other < 0),
+        rational::detail::rounded_quotient(Word{magnitude(numer_)}, magnitude(other))));
+    return *this;
+}
+
+template <std::signed_integral T, class Scale>
+constexpr bool operator==(const FixedRational<T, Scale>& lhs, const FixedRational<T, Scale>& rhs) noexcept
+{
+    return lhs.numer() == rhs.numer();
+}
+template <std::signed_integral T, class Scale>
+constexpr bool operator==(const FixedRational<T, Scale>& lhs, const Rational<T>& rhs) noexcept
+{
+    return static_cast<Rational<T>>(lhs) == rhs;
+}
+template <std::signed_integral T, class Scale>
+constexpr bool operator!=(const FixedRational<T, Scale>& lhs, const FixedRational<T, Scale>& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+template <std::signed_integral T, class Scale>
+constexpr bool operator!=(const FixedRational<T, Scale>& lhs, const Rational<T>& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+template <std::signed_integral T, class Scale>
+constexpr std::strong_ordering operator<=>(const FixedRational<T, Scale>& lhs, const FixedRational<T, Scale>& rhs) noexcept
+{
+    return lhs.numer() <=> rhs.numer();
+}
+
+template <std::signed_integral T, class Scale>
+constexpr FixedRational<T, Scale> operator+(const FixedRational<T, Scale>& lhs, const FixedRational<T, Scale>& rhs) noexcept(rational::nothrow_overflow_v<T>)
+{
+    return FixedRational<T, Scale>{lhs} += rhs;
+}
+template <std::signed_integral T, class Scale>
+constexpr FixedRational<T, Scale> operator-(const FixedRational<T, Scale>& lhs, const FixedRational<T, Scale>& rhs) noexcept(rational::nothrow_overflow_v<T>)
+{
+    return FixedRational<T, Scale>{lhs} -= rhs;
+}
+template <std::signed_integral T, class Scale>
+constexpr FixedRational<T, Scale> operator*(const FixedRational<T, Scale>& lhs, const FixedRational<T, Scale>& rhs) noexcept(rational::nothrow_overflow_v<T>)
+{
+    return FixedRational<T, Scale>{lhs} *= rhs;
+}
+template <std::signed_integral T, class Scale>
+constexpr FixedRational<T, Scale> operator/(const FixedRational<T, Scale>& lhs, const FixedRational<T, Scale>& rhs)
+{
+    return FixedRational<T, Scale>{lhs} /= rhs;
+}
+
+template <std::signed_integral T, class Scale, rational::fixed_operand<T> U>
+constexpr FixedRational<T, Scale> operator+(const FixedRational<T, Scale>& lhs, U rhs) noexcept(rational::nothrow_overflow_v<T>)
+{
+    return FixedRational<T, Scale>{lhs} += static_cast<T>(rhs);
+}
+template <std::signed_integral T, class Scale, rational::fixed_operand<T> U>
+constexpr FixedRational<T, Scale> operator-(const FixedRational<T, Scale>& lhs, U rhs) noexcept(rational::nothrow_overflow_v<T>)
+{
+    return FixedRational<T, Scale>{lhs} -= static_cast<T>(rhs);
+}
+template <std::signed_integral T, class Scale, rational::fixed_operand<T> U>
+constexpr FixedRational<T, Scale> operator*(const FixedRational<T, Scale>& lhs, U rhs) noexcept(rational::nothrow_overflow_v<T>)
+{
+    return FixedRational<T, Scale>{lhs} *= static_cast<T>(rhs);
+}
+template <std::signed_integral T, class Scale, rational::fixed_operand<T> U>
+constexpr FixedRational<T, Scale> operator/(const FixedRational<T, Scale>& lhs, U rhs)
+{
+    return FixedRational<T, Scale>{lhs} /= static_cast<T>(rhs);
+}
+
+template <std::signed_integral T, class Scale, rational::fixed_operand<T> U>
+constexpr FixedRational<T, Scale> operator+(U lhs, const FixedRational<T, Scale>& rhs) noexcept(rational::nothrow_overflow_v<T>)
+{
+    return rhs + lhs;
+}
+template <std::signed_integral T, class Scale, rational::fixed_operand<T> U>
+constexpr FixedRational<T, Scale> operator-(U lhs, const FixedRational<T, Scale>& rhs) noexcept(rational::nothrow_overflow_v<T>)
+{
+    return FixedRational<T, Scale>{static_cast<T>(lhs)} -= rhs;
+}
+template <std::signed_integral T, class Scale, rational::fixed_operand<T> U>
+constexpr FixedRational<T, Scale> operator*(U lhs, const FixedRational<T, Scale>& rhs) noexcept(rational::nothrow_overflow_v<T>)
+{
+    return rhs * lhs;
+}
+template <std::signed_integral T, class Scale, rational::fixed_operand<T> U>
+constexpr FixedRational<T, Scale> operator/(U lhs, const FixedRational<T, Scale>& rhs)
+{
+    return FixedRational<T, Scale>{static_cast<T>(lhs)} /= rhs;
+}
+
+template <std::signed_integral T, class Scale>
+std::size_t std::hash<FixedRational<T, Scale>>::operator()(const FixedRational<T, Scale>& value) const noexcept
+{
+    return std::hash<T>{}(value.numer());
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "rational.hpp"
+
+#include <compare>
+#include <concepts>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+template <std::signed_integral T>
+struct LazyRational {
+    using NumeratorType = T;
+    using DenominatorType = std::make_unsigned_t<T>;
+
+    explicit constexpr LazyRational(NumeratorType, DenominatorType = 1);
+    explicit constexpr LazyRational(NumeratorType, NumeratorType);
+    constexpr LazyRational(const Rational<T>&) noexcept;
+
+    constexpr LazyRational(const LazyRational&) noexcept = default;
+    constexpr LazyRational(LazyRational&&) noexcept = default;
+    constexpr LazyRational& operator=(const LazyRational&) noexcept = default;
+    constexpr LazyRational& operator=(LazyRational&&) noexcept = default;
+
+    constexpr NumeratorType numer() const noexcept { return canonical().numer(); }
+    constexpr DenominatorType denom() const noexcept { return canonical().denom(); }
+    constexpr bool reduced() const noexcept { return reduced_; }
+
+    constexpr LazyRational& normalize() noexcept;
+    constexpr Rational<T> canonical() const noexcept;
+    constexpr operator Rational<T>() const noexcept { return canonical(); }
+
+    template <class U>
+    explicit constexpr operator U() const noexcept;
+
+    constexpr LazyRational operator+() const noexcept;
+    constexpr LazyRational operator-() const noexcept;
+    constexpr LazyRational inverse() const;
+
+    constexpr LazyRational& operator+=(const LazyRational&) noexcept(rational::nothrow_overflow_v<T>);
+    constexpr LazyRational& operator-=(const LazyRational&) noexcept(rational::nothrow_overflow_v<T>);
+    constexpr LazyRational& operator*=(const LazyRational&) noexcept(rational::nothrow_overflow_v<T>);
+    constexpr LazyRational& operator/=(const LazyRational&);
+
+    constexpr LazyRational& operator+=(T) noexcept(rational::nothrow_overflow_v<T>);
+    constexpr LazyRational& operator-=(T) noexcept(rational::nothrow_overflow_v<T>);
+    constexpr LazyRational& operator*=(T) noexcept(rational::nothrow_overflow_v<T>);
+    constexpr LazyRational& operator/=(T);
+
+private:
+    NumeratorType numer_;
+    DenominatorType denom_;
+    bool reduced_;
+
+    constexpr static int numer_bits_ = std::numeric_limits<NumeratorType>::digits;
+    constexpr static int denom_bits_ = std::numeric_limits<DenominatorType>::digits;
+
+    constexpr const LazyRational& check_zero_denominator() const;
+
+    using SimpleCopy = decltype(std::placeholders::_1);
+    constexpr static SimpleCopy simple_copy_{};
+    explicit constexpr LazyRational(SimpleCopy, NumeratorType, DenominatorType, bool);
+};
+
+template <std::signed_integral T>
+constexpr bool operator==(const LazyRational<T>&, const LazyRational<T>&) noexcept;
+template <std::signed_integral T>
+constexpr bool operator==(const LazyRational<T>&, const Rational<T>&) noexcept;
+template <std::signed_integral T>
+constexpr bool operator!=(const LazyRational<T>&, const LazyRational<T>&) noexcept;
+
+template <std::signed_integral T>
+constexpr std::strong_ordering operator<=>(const LazyRational<T>&, const LazyRational<T>&) noexcept;
+template <std::signed_integral T>
+constexpr std::strong_ordering operator<=>(const LazyRational<T>&, const Rational<T>&) noexcept;
+
+template <std::signed_integral T>
+constexpr LazyRational<T> operator+(const LazyRational<T>&, const LazyRational<T>&) noexcept(rational::nothrow_overflow_v<T>);
+template <std::signed_integral T>
+constexpr LazyRational<T> operator-(const LazyRational<T>&, const LazyRational<T>&) noexcept(rational::nothrow_overflow_v<T>);
+template <std::signed_integral T>
+constexpr LazyRational<T> operator*(const LazyRational<T>&, const LazyRational<T>&) noexcept(rational::nothrow_overflow_v<T>);
+template <std::signed_integral T>
+constexpr LazyRational<T> operator/(const LazyRational<T>&, const LazyRational<T>&);
+
+template <std::signed_integral T>
+constexpr LazyRational<T> operator+(const LazyRational<T>&, T) noexcept(rational::nothrow_overflow_v<T>);
+template <std::signed_integral T>
+constexpr LazyRational<T> operator-(const LazyRational<T>&, T) noexcept(rational::nothrow_overflow_v<T>);
+template <std::signed_integral T>
+constexpr LazyRational<T> operator*(const LazyRational<T>&, T) noexcept(rational::nothrow_overflow_v<T>);
+template <std::signed_integral T>
+constexpr LazyRational<T> operator/(const LazyRational<T>&, T);
+
+template <std::signed_integral T>
+struct std::hash<LazyRational<T>> {
+    std::size_t operator()(const LazyRational<T>&) const noexcept;
+};
+
+#include "lazy_rational.ipp"
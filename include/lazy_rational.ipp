@@ -0,0 +1,254 @@
+#pragma once
+
+#include "lazy_rational.hpp"
+#include "rational_gcd.hpp"
+
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <stdexcept>
+
+template <std::signed_integral T>
+constexpr auto LazyRational<T>::check_zero_denominator() const -> const LazyRational&
+{
+    if (denom_ == 0) {
+        throw std::range_error{"0 is given as denom of Rational"};
+    }
+    return *this;
+}
+template <std::signed_integral T>
+constexpr auto LazyRational<T>::normalize() noexcept -> LazyRational&
+{
+    if (!reduced_) {
+        rational::detail::reduce(numer_, denom_);
+        reduced_ = true;
+    }
+    return *this;
+}
+template <std::signed_integral T>
+constexpr Rational<T> LazyRational<T>::canonical() const noexcept
+{
+    auto numer = numer_;
+    auto denom = denom_;
+    if (!reduced_) {
+        rational::detail::reduce(numer, denom);
+    }
+    return Rational<T>{Rational<T>::simple_copy_, numer, denom};
+}
+
+template <std::signed_integral T>
+constexpr LazyRational<T>::LazyRational(NumeratorType numer, DenominatorType denom) : LazyRational{simple_copy_, numer, denom, denom == 1}
+{
+    check_zero_denominator();
+}
+template <std::signed_integral T>
+constexpr LazyRational<T>::LazyRational(NumeratorType numer, NumeratorType denom)
+    : LazyRational{static_cast<NumeratorType>(std::signbit(denom) ? -numer : numer), static_cast<DenominatorType>(std::abs(denom))}
+{
+}
+template <std::signed_integral T>
+constexpr LazyRational<T>::LazyRational(const Rational<T>& value) noexcept : LazyRational{simple_copy_, value.numer(), value.denom(), true}
+{
+}
+template <std::signed_integral T>
+constexpr LazyRational<T>::LazyRational(SimpleCopy, NumeratorType numer, DenominatorType denom, bool reduced)
+    : numer_{numer}, denom_{denom}, reduced_{reduced}
+{
+}
+
+template <std::signed_integral T>
+template <class U>
+constexpr LazyRational<T>::operator U() const noexcept
+{
+    return static_cast<U>(canonical());
+}
+
+template <std::signed_integral T>
+constexpr auto LazyRational<T>::operator+() const noexcept -> LazyRational
+{
+    return *this;
+}
+template <std::signed_integral T>
+constexpr auto LazyRational<T>::operator-() const noexcept -> LazyRational
+{
+    return LazyRational{simple_copy_, static_cast<NumeratorType>(-numer_), denom_, reduced_};
+}
+template <std::signed_integral T>
+constexpr auto LazyRational<T>::inverse() const -> LazyRational
+{
+    if (rational::detail::bit_width(denom_) > numer_bits_) {
+        return LazyRational{canonical().inverse()};
+    }
+    auto tmp = static_cast<NumeratorType>(denom_);
+    return LazyRational{simple_copy_, static_cast<NumeratorType>(numer_ < 0 ? -tmp : tmp), rational::detail::magnitude(numer_), reduced_}.check_zero_denominator();
+}
+
+template <std::signed_integral T>
+constexpr auto LazyRational<T>::operator+=(const LazyRational& other) noexcept(rational::nothrow_overflow_v<T>) -> LazyRational&
+{
+    using rational::detail::bit_width;
+
+    if (denom_ == other.denom_) {
+        if (bit_width(numer_) < numer_bits_ && bit_width(other.numer_) < numer_bits_) {
+            numer_ = static_cast<NumeratorType>(numer_ + other.numer_);
+            reduced_ = denom_ == 1;
+            return *this;
+        }
+    } else if (bit_width(numer_) + bit_width(other.denom_) < numer_bits_
+               && bit_width(other.numer_) + bit_width(denom_) < numer_bits_
+               && bit_width(denom_) + bit_width(other.denom_) <= denom_bits_) {
+        numer_ = static_cast<NumeratorType>(
+            numer_ * static_cast<NumeratorType>(other.denom_)
+            + static_cast<NumeratorType>(denom_) * other.numer_);
+        denom_ = static_cast<DenominatorType>(denom_ * other.denom_);
+        reduced_ = false;
+        return *this;
+    }
+    return *this = LazyRational{canonical() + other.canonical()};
+}
+template <std::signed_integral T>
+constexpr auto LazyRational<T>::operator-=(const LazyRational& other) noexcept(rational::nothrow_overflow_v<T>) -> LazyRational&
+{
+    return *this += (-other);
+}
+template <std::signed_integral T>
+constexpr auto LazyRational<T>::operator*=(const LazyRational& other) noexcept(rational::nothrow_overflow_v<T>) -> LazyRational&
+{
+    using rational::detail::bit_width;
+
+    if (bit_width(numer_) + bit_width(other.numer_) <= numer_bits_
+        && bit_width(denom_) + bit_width(other.denom_) <= denom_bits_) {
+        numer_ = static_cast<NumeratorType>(numer_ * other.numer_);
+        denom_ = static_cast<DenominatorType>(denom_ * other.denom_);
+        reduced_ = denom_ == 1;
+        return *this;
+    }
+    return *this = LazyRational{canonical() * other.canonical()};
+}
+template <std::signed_integral T>
+constexpr auto LazyRational<T>::operator/=(const LazyRational& other) -> LazyRational&
+{
+    return *this *= other.inverse();
+}
+
+template <std::signed_integral T>
+constexpr auto LazyRational<T>::operator+=(T other) noexcept(rational::nothrow_overflow_v<T>) -> LazyRational&
+{
+    using rational::detail::bit_width;
+
+    if (bit_width(numer_) < numer_bits_ && bit_width(denom_) + bit_width(other) < numer_bits_) {
+        numer_ = static_cast<NumeratorType>(numer_ + static_cast<NumeratorType>(denom_) * other);
+        return *this;
+    }
+    return *this = LazyRational{canonical() + other};
+}
+template <std::signed_integral T>
+constexpr auto LazyRational<T>::operator-=(T other) noexcept(rational::nothrow_overflow_v<T>) -> LazyRational&
+{
+    return *this += static_cast<T>(-other);
+}
+template <std::signed_integral T>
+constexpr auto LazyRational<T>::operator*=(T other) noexcept(rational::nothrow_overflow_v<T>) -> LazyRational&
+{
+    using rational::detail::bit_width;
+
+    if (bit_width(numer_) + bit_width(other) <= numer_bits_) {
+        numer_ = static_cast<NumeratorType>(numer_ * other);
+        reduced_ = denom_ == 1;
+        return *this;
+    }
+    return *this = LazyRational{canonical() * other};
+}
+template <std::signed_integral T>
+constexpr auto LazyRational<T>::operator/=(T other) -> LazyRational&
+{
+    using rational::detail::bit_width;
+
+    if (other == 0) {
+        throw std::range_error{"0 is given as denom of Rational"};
+    }
+    if (bit_width(numer_) <= numer_bits_ && bit_width(denom_) + bit_width(other) <= denom_bits_) {
+        if (other < 0) {
+            numer_ = static_cast<NumeratorType>(-numer_);
+        }
+        denom_ = static_cast<DenominatorType>(denom_ * rational::detail::magnitude(other));
+        reduced_ = false;
+        return *this;
+    }
+    return *this = LazyRational{canonical() / other};
+}
+
+template <std::signed_integral T>
+constexpr bool operator==(const LazyRational<T>& lhs, const LazyRational<T>& rhs) noexcept
+{
+    return lhs.canonical() == rhs.canonical();
+}
+template <std::signed_integral T>
+constexpr bool operator==(const LazyRational<T>& lhs, const Rational<T>& rhs) noexcept
+{
+    return lhs.canonical() == rhs;
+}
+template <std::signed_integral T>
+constexpr bool operator!=(const LazyRational<T>& lhs, const LazyRational<T>& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+template <std::signed_integral T>
+constexpr std::strong_ordering operator<=>(const LazyRational<T>& lhs, const LazyRational<T>& rhs) noexcept
+{
+    return lhs.canonical() <=> rhs.canonical();
+}
+template <std::signed_integral T>
+constexpr std::strong_ordering operator<=>(const LazyRational<T>& lhs, const Rational<T>& rhs) noexcept
+{
+    return lhs.canonical() <=> rhs;
+}
+
+template <std::signed_integral T>
+constexpr LazyRational<T> operator+(const LazyRational<T>& lhs, const LazyRational<T>& rhs) noexcept(rational::nothrow_overflow_v<T>)
+{
+    return LazyRational<T>{lhs} += rhs;
+}
+template <std::signed_integral T>
+constexpr LazyRational<T> operator-(const LazyRational<T>& lhs, const LazyRational<T>& rhs) noexcept(rational::nothrow_overflow_v<T>)
+{
+    return LazyRational<T>{lhs} -= rhs;
+}
+template <std::signed_integral T>
+constexpr LazyRational<T> operator*(const LazyRational<T>& lhs, const LazyRational<T>& rhs) noexcept(rational::nothrow_overflow_v<T>)
+{
+    return LazyRational<T>{lhs} *= rhs;
+}
+template <std::signed_integral T>
+constexpr LazyRational<T> operator/(const LazyRational<T>& lhs, const LazyRational<T>& rhs)
+{
+    return LazyRational<T>{lhs} /= rhs;
+}
+
+template <std::signed_integral T>
+constexpr LazyRational<T> operator+(const LazyRational<T>& lhs, T rhs) noexcept(rational::nothrow_overflow_v<T>)
+{
+    return LazyRational<T>{lhs} += rhs;
+}
+template <std::signed_integral T>
+constexpr LazyRational<T> operator-(const LazyRational<T>& lhs, T rhs) noexcept(rational::nothrow_overflow_v<T>)
+{
+    return LazyRational<T>{lhs} -= rhs;
+}
+template <std::signed_integral T>
+constexpr LazyRational<T> operator*(const LazyRational<T>& lhs, T rhs) noexcept(rational::nothrow_overflow_v<T>)
+{
+    return LazyRational<T>{lhs} *= rhs;
+}
+template <std::signed_integral T>
+constexpr LazyRational<T> operator/(const LazyRational<T>& lhs, T rhs)
+{
+    return LazyRational<T>{lhs} /= rhs;
+}
+
+template <std::signed_integral T>
+std::size_t std::hash<LazyRational<T>>::operator()(const LazyRational<T>& value) const noexcept
+{
+    return std::hash<Rational<T>>{}(value.canonical());
+}
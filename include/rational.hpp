@@ -1,10 +1,27 @@
 #pragma once
 
+#include "rational_floating.hpp"
+#include "rational_wide.hpp"
+
+#include <compare>
 #include <concepts>
 #include <functional>
+#include <limits>
 #include <ratio>
 #include <type_traits>
 
+template <std::signed_integral T>
+struct LazyRational;
+template <class Allocator>
+struct BasicBigRational;
+template <std::signed_integral T>
+struct RationalArray;
+namespace rational::detail
+{
+template <std::signed_integral T>
+struct Accumulator;
+}  // namespace rational::detail
+
 template <std::signed_integral T>
 struct Rational {
     using NumeratorType = T;
@@ -15,6 +32,10 @@ struct Rational {
     template <intmax_t N, intmax_t D>
     explicit constexpr Rational(std::ratio<N, D>);
 
+    // The nearest fraction whose denominator is at most max_denominator
+    template <rational::detail::binary_floating F>
+    constexpr static Rational from_floating(F, DenominatorType max_denominator = std::numeric_limits<DenominatorType>::max());
+
     constexpr Rational(const Rational&) noexcept = default;
     constexpr Rational(Rational&&) noexcept = default;
     constexpr Rational& operator=(const Rational&) noexcept = default;
@@ -23,6 +44,10 @@ struct Rational {
     constexpr NumeratorType numer() const noexcept { return numer_; }
     constexpr DenominatorType denom() const noexcept { return denom_; }
 
+    // Rounded once, to nearest even
+    constexpr double to_double() const noexcept { return rational::detail::to_floating<double>(numer_, denom_); }
+    constexpr float to_float() const noexcept { return rational::detail::to_floating<float>(numer_, denom_); }
+
     template <class U>
     explicit constexpr operator U() const noexcept;
     template <std::signed_integral U>
@@ -42,19 +67,27 @@ struct Rational {
     constexpr Rational operator-() const noexcept;
     constexpr Rational inverse() const;
 
-    constexpr Rational& operator+=(const Rational&) noexcept;
-    constexpr Rational& operator-=(const Rational&) noexcept;
-    constexpr Rational& operator*=(const Rational&) noexcept;
+    constexpr Rational& operator+=(const Rational&) noexcept(rational::nothrow_overflow_v<T>);
+    constexpr Rational& operator-=(const Rational&) noexcept(rational::nothrow_overflow_v<T>);
+    constexpr Rational& operator*=(const Rational&) noexcept(rational::nothrow_overflow_v<T>);
     constexpr Rational& operator/=(const Rational&);
 
-    constexpr Rational& operator+=(T) noexcept;
-    constexpr Rational& operator-=(T) noexcept;
-    constexpr Rational& operator*=(T) noexcept;
+    constexpr Rational& operator+=(T) noexcept(rational::nothrow_overflow_v<T>);
+    constexpr Rational& operator-=(T) noexcept(rational::nothrow_overflow_v<T>);
+    constexpr Rational& operator*=(T) noexcept(rational::nothrow_overflow_v<T>);
     constexpr Rational& operator/=(T);
 
 private:
     template <std::signed_integral U>
     friend class Rational;
+    template <std::signed_integral U>
+    friend struct LazyRational;
+    template <class Allocator>
+    friend struct BasicBigRational;
+    template <std::signed_integral U>
+    friend struct RationalArray;
+    template <std::signed_integral U>
+    friend struct rational::detail::Accumulator;
 
     NumeratorType numer_;
     DenominatorType denom_;
@@ -73,41 +106,40 @@ template <std::signed_integral T, std::signed_integral U>
 requires std::common_with<T, U> constexpr bool operator!=(const Rational<T>&, const Rational<U>&) noexcept;
 
 template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr bool operator<(const Rational<T>& lhs, const Rational<U>& rhs) noexcept;
-template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr bool operator>(const Rational<T>& lhs, const Rational<U>& rhs) noexcept;
-template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr bool operator<=(const Rational<T>& lhs, const Rational<U>& rhs) noexcept;
-template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr bool operator>=(const Rational<T>& lhs, const Rational<U>& rhs) noexcept;
+requires std::common_with<T, U> constexpr std::strong_ordering operator<=>(const Rational<T>& lhs, const Rational<U>& rhs) noexcept;
 
 template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator+(const Rational<T>&, const Rational<U>&) noexcept;
+requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator+(const Rational<T>&, const Rational<U>&) noexcept(rational::nothrow_overflow_v<std::common_type_t<T, U>>);
 template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator-(const Rational<T>&, const Rational<U>&) noexcept;
+requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator-(const Rational<T>&, const Rational<U>&) noexcept(rational::nothrow_overflow_v<std::common_type_t<T, U>>);
 template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator*(const Rational<T>&, const Rational<U>&) noexcept;
+requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator*(const Rational<T>&, const Rational<U>&) noexcept(rational::nothrow_overflow_v<std::common_type_t<T, U>>);
 template <std::signed_integral T, std::signed_integral U>
 requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator/(const Rational<T>&, const Rational<U>&);
 
 template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator+(const Rational<T>&, U) noexcept;
+requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator+(const Rational<T>&, U) noexcept(rational::nothrow_overflow_v<std::common_type_t<T, U>>);
 template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator-(const Rational<T>&, U) noexcept;
+requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator-(const Rational<T>&, U) noexcept(rational::nothrow_overflow_v<std::common_type_t<T, U>>);
 template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator*(const Rational<T>&, U) noexcept;
+requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator*(const Rational<T>&, U) noexcept(rational::nothrow_overflow_v<std::common_type_t<T, U>>);
 template <std::signed_integral T, std::signed_integral U>
 requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator/(const Rational<T>&, U);
 
 template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator+(T, const Rational<U>&) noexcept;
+requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator+(T, const Rational<U>&) noexcept(rational::nothrow_overflow_v<std::common_type_t<T, U>>);
 template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator-(T, const Rational<U>&) noexcept;
+requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator-(T, const Rational<U>&) noexcept(rational::nothrow_overflow_v<std::common_type_t<T, U>>);
 template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator*(T, const Rational<U>&) noexcept;
+requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator*(T, const Rational<U>&) noexcept(rational::nothrow_overflow_v<std::common_type_t<T, U>>);
 template <std::signed_integral T, std::signed_integral U>
 requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator/(T, const Rational<U>&);
 
+template <std::signed_integral T>
+struct std::hash<Rational<T>> {
+    std::size_t operator()(const Rational<T>&) const noexcept;
+};
+
 namespace
 {
 struct ratio_impl {
@@ -1,10 +1,15 @@
 #pragma once
 
 #include "rational.hpp"
+#include "rational_floating.hpp"
+#include "rational_gcd.hpp"
+#include "rational_wide.hpp"
 
+#include <algorithm>
+#include <bit>
 #include <cmath>
+#include <compare>
 #include <concepts>
-#include <numeric>
 #include <stdexcept>
 
 template <std::signed_integral T>
@@ -18,9 +23,7 @@ constexpr auto Rational<T>::check_zero_denominator() const -> const Rational&
 template <std::signed_integral T>
 constexpr auto Rational<T>::reduction() noexcept -> Rational&
 {
-    const auto gcd = std::gcd(numer_, static_cast<NumeratorType>(denom_));
-    numer_ = static_cast<NumeratorType>(numer_ / gcd);
-    denom_ = static_cast<DenominatorType>(denom_ / gcd);
+    rational::detail::reduce(numer_, denom_);
     return *this;
 }
 
@@ -50,11 +53,72 @@ constexpr Rational<T>::Rational(SimpleCopy, NumeratorType numer, DenominatorType
 template <intmax_t N, intmax_t D>
 Rational(std::ratio<N, D>) -> Rational<intmax_t>;
 
+template <std::signed_integral T>
+template <rational::detail::binary_floating F>
+constexpr auto Rational<T>::from_floating(F value, DenominatorType max_denominator) -> Rational
+{
+    using Word = rational::detail::uint128_t;
+    using Policy = rational::overflow_policy_t<T>;
+
+    if (max_denominator == 0) {
+        throw std::range_error{"0 is given as denom of Rational"};
+    }
+    const auto parts = rational::detail::decompose(value);
+    if (!parts.finite) {
+        throw std::domain_error{"non-finite value is given to Rational"};
+    }
+    auto mantissa = parts.mantissa;
+    auto exponent = parts.exponent;
+    if (mantissa == 0) {
+        return Rational{simple_copy_, 0, 1};
+    }
+    if (exponent < 0) {
+        const auto zeros = std::min(std::countr_zero(mantissa), -exponent);
+        mantissa >>= zeros;
+        exponent += zeros;
+    }
+
+    // The integer part, modulo 2^128
+    const Word integer = exponent >= 128 ? 0 : exponent >= 0 ? Word{mantissa} << exponent : exponent > -64 ? mantissa >> -exponent : 0;
+    const auto limit = static_cast<Word>(static_cast<Word>(std::numeric_limits<T>::max()) + (parts.negative ? 1 : 0));
+    if (rational::detail::bit_width(mantissa) + exponent > 64 || integer > limit) [[unlikely]] {
+        if constexpr (std::is_same_v<Policy, rational::ThrowOnOverflow>) {
+            throw std::overflow_error{"value given to Rational overflows"};
+        } else if constexpr (std::is_same_v<Policy, rational::SaturateOnOverflow>) {
+            return Rational{simple_copy_, parts.negative ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max(), 1};
+        } else {
+            return Rational{simple_copy_, rational::detail::with_sign<T>(parts.negative, static_cast<DenominatorType>(integer)), 1};
+        }
+    }
+    if (exponent >= 0) {
+        return Rational{simple_copy_, rational::detail::with_sign<T>(parts.negative, static_cast<DenominatorType>(integer)), 1};
+    }
+    // Below 2^-67 the nearest fraction with any DenominatorType denominator is 0
+    if (exponent < -119) {
+        return Rational{simple_copy_, 0, 1};
+    }
+
+    const auto approximate = [&]<class U>(U numer, U denom) {
+        rational::detail::approximate(numer, denom, static_cast<U>(limit), U{max_denominator});
+        return Rational{simple_copy_,
+            rational::detail::with_sign<T>(parts.negative && numer != 0, static_cast<DenominatorType>(numer)),
+            static_cast<DenominatorType>(denom)};
+    };
+    if (exponent > -64) {
+        return approximate(mantissa, std::uint64_t{1} << -exponent);
+    }
+    return approximate(Word{mantissa}, Word{1} << -exponent);
+}
+
 template <std::signed_integral T>
 template <class U>
 constexpr Rational<T>::operator U() const noexcept
 {
-    return static_cast<U>(static_cast<U>(numer_) / static_cast<U>(denom_));
+    if constexpr (rational::detail::binary_floating<U>) {
+        return rational::detail::to_floating<U>(numer_, denom_);
+    } else {
+        return static_cast<U>(static_cast<U>(numer_) / static_cast<U>(denom_));
+    }
 }
 
 template <std::signed_integral T>
@@ -70,59 +134,65 @@ constexpr auto Rational<T>::operator-() const noexcept -> Rational
 template <std::signed_integral T>
 constexpr auto Rational<T>::inverse() const -> Rational
 {
-    auto tmp = static_cast<NumeratorType>(denom_);
-    return Rational{simple_copy_, static_cast<NumeratorType>(numer_ < 0 ? -tmp : tmp), static_cast<DenominatorType>(std::abs(numer_))}.check_zero_denominator();
+    Rational result{simple_copy_, 0, 0};
+    rational::detail::narrow<T>({numer_ < 0, denom_, rational::detail::magnitude(numer_)}, result.numer_, result.denom_);
+    return result.check_zero_denominator();
 }
 
 template <std::signed_integral T>
-constexpr auto Rational<T>::operator+=(const Rational& other) noexcept -> Rational&
+constexpr auto Rational<T>::operator+=(const Rational& other) noexcept(rational::nothrow_overflow_v<T>) -> Rational&
 {
-    const auto gcd = std::gcd(denom_, other.denom_);
-    const auto this_denom_coeff = denom_ / gcd, other_denom_coeff = other.denom_ / gcd;
-
-    return *this = Rational{simple_copy_,
-               static_cast<NumeratorType>(
-                   numer_ * static_cast<NumeratorType>(other_denom_coeff)
-                   + static_cast<NumeratorType>(this_denom_coeff) * other.numer_),
-               static_cast<DenominatorType>(denom_ * other_denom_coeff)}
-                       .reduction();
+    rational::detail::narrow(rational::detail::wide_sum(numer_, denom_, other.numer_, other.denom_), numer_, denom_);
+    return *this;
 }
 template <std::signed_integral T>
-constexpr auto Rational<T>::operator-=(const Rational& other) noexcept -> Rational&
+constexpr auto Rational<T>::operator-=(const Rational& other) noexcept(rational::nothrow_overflow_v<T>) -> Rational&
 {
-    return *this += (-other);
+    rational::detail::narrow(rational::detail::wide_sum(numer_, denom_, other.numer_, other.denom_, true), numer_, denom_);
+    return *this;
 }
 template <std::signed_integral T>
-constexpr auto Rational<T>::operator*=(const Rational& other) noexcept -> Rational&
+constexpr auto Rational<T>::operator*=(const Rational& other) noexcept(rational::nothrow_overflow_v<T>) -> Rational&
 {
-    return *this = Rational{simple_copy_, static_cast<NumeratorType>(numer_ * other.numer_), static_cast<DenominatorType>(denom_ * other.denom_)}.reduction();
+    rational::detail::narrow(rational::detail::wide_product(numer_, denom_, other.numer_, other.denom_), numer_, denom_);
+    return *this;
 }
 template <std::signed_integral T>
 constexpr auto Rational<T>::operator/=(const Rational& other) -> Rational&
 {
-    return *this *= other.inverse();
+    if (other.numer_ == 0) {
+        throw std::range_error{"0 is given as denom of Rational"};
+    }
+    rational::detail::narrow(rational::detail::wide_quotient(numer_, denom_, other.numer_, other.denom_), numer_, denom_);
+    return *this;
 }
 
 template <std::signed_integral T>
-constexpr auto Rational<T>::operator+=(T other) noexcept -> Rational&
+constexpr auto Rational<T>::operator+=(T other) noexcept(rational::nothrow_overflow_v<T>) -> Rational&
 {
-    numer_ = static_cast<NumeratorType>(numer_ + static_cast<NumeratorType>(denom_) * other);
+    rational::detail::narrow(rational::detail::wide_sum(numer_, denom_, other), numer_, denom_);
     return *this;
 }
 template <std::signed_integral T>
-constexpr auto Rational<T>::operator-=(T other) noexcept -> Rational&
+constexpr auto Rational<T>::operator-=(T other) noexcept(rational::nothrow_overflow_v<T>) -> Rational&
 {
-    return *this += (-other);
+    rational::detail::narrow(rational::detail::wide_sum(numer_, denom_, other, true), numer_, denom_);
+    return *this;
 }
 template <std::signed_integral T>
-constexpr auto Rational<T>::operator*=(T other) noexcept -> Rational&
+constexpr auto Rational<T>::operator*=(T other) noexcept(rational::nothrow_overflow_v<T>) -> Rational&
 {
-    return *this = Rational{simple_copy_, static_cast<NumeratorType>(numer_ * other), denom_}.reduction();
+    rational::detail::narrow(rational::detail::wide_product(numer_, denom_, other), numer_, denom_);
+    return *this;
 }
 template <std::signed_integral T>
 constexpr auto Rational<T>::operator/=(T other) -> Rational&
 {
-    return *this = Rational{numer_, static_cast<NumeratorType>(static_cast<NumeratorType>(denom_) * other)};
+    if (other == 0) {
+        throw std::range_error{"0 is given as denom of Rational"};
+    }
+    rational::detail::narrow(rational::detail::wide_quotient(numer_, denom_, other), numer_, denom_);
+    return *this;
 }
 
 template <std::signed_integral T, std::signed_integral U>
@@ -137,39 +207,24 @@ requires std::common_with<T, U> constexpr bool operator!=(const Rational<T>& lhs
 }
 
 template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr bool operator<(const Rational<T>& lhs, const Rational<U>& rhs) noexcept
-{
-    using NumeratorType = std::common_type_t<T, U>;
-    return lhs.numer() * static_cast<NumeratorType>(rhs.denom()) < rhs.numer() * static_cast<NumeratorType>(lhs.denom());
-}
-template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr bool operator>(const Rational<T>& lhs, const Rational<U>& rhs) noexcept
+requires std::common_with<T, U> constexpr std::strong_ordering operator<=>(const Rational<T>& lhs, const Rational<U>& rhs) noexcept
 {
-    return rhs < lhs;
-}
-template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr bool operator<=(const Rational<T>& lhs, const Rational<U>& rhs) noexcept
-{
-    return !(lhs > rhs);
-}
-template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr bool operator>=(const Rational<T>& lhs, const Rational<U>& rhs) noexcept
-{
-    return !(lhs < rhs);
+    using WideType = rational::detail::wide_signed_t<std::common_type_t<T, U>>;
+    return WideType{lhs.numer()} * WideType{rhs.denom()} <=> WideType{rhs.numer()} * WideType{lhs.denom()};
 }
 
 template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator+(const Rational<T>& lhs, const Rational<U>& rhs) noexcept
+requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator+(const Rational<T>& lhs, const Rational<U>& rhs) noexcept(rational::nothrow_overflow_v<std::common_type_t<T, U>>)
 {
     return Rational<std::common_type_t<T, U>>{lhs} += rhs;
 }
 template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator-(const Rational<T>& lhs, const Rational<U>& rhs) noexcept
+requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator-(const Rational<T>& lhs, const Rational<U>& rhs) noexcept(rational::nothrow_overflow_v<std::common_type_t<T, U>>)
 {
     return Rational<std::common_type_t<T, U>>{lhs} -= rhs;
 }
 template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator*(const Rational<T>& lhs, const Rational<U>& rhs) noexcept
+requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator*(const Rational<T>& lhs, const Rational<U>& rhs) noexcept(rational::nothrow_overflow_v<std::common_type_t<T, U>>)
 {
     return Rational<std::common_type_t<T, U>>{lhs} *= rhs;
 }
@@ -180,17 +235,17 @@ requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> ope
 }
 
 template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator+(const Rational<T>& lhs, U rhs) noexcept
+requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator+(const Rational<T>& lhs, U rhs) noexcept(rational::nothrow_overflow_v<std::common_type_t<T, U>>)
 {
     return Rational<std::common_type_t<T, U>>{lhs} += rhs;
 }
 template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator-(const Rational<T>& lhs, U rhs) noexcept
+requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator-(const Rational<T>& lhs, U rhs) noexcept(rational::nothrow_overflow_v<std::common_type_t<T, U>>)
 {
     return Rational<std::common_type_t<T, U>>{lhs} -= rhs;
 }
 template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator*(const Rational<T>& lhs, U rhs) noexcept
+requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator*(const Rational<T>& lhs, U rhs) noexcept(rational::nothrow_overflow_v<std::common_type_t<T, U>>)
 {
     return Rational<std::common_type_t<T, U>>{lhs} *= rhs;
 }
@@ -201,17 +256,17 @@ requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> ope
 }
 
 template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator+(T lhs, const Rational<U>& rhs) noexcept
+requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator+(T lhs, const Rational<U>& rhs) noexcept(rational::nothrow_overflow_v<std::common_type_t<T, U>>)
 {
     return rhs + lhs;
 }
 template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator-(T lhs, const Rational<U>& rhs) noexcept
+requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator-(T lhs, const Rational<U>& rhs) noexcept(rational::nothrow_overflow_v<std::common_type_t<T, U>>)
 {
     return lhs + (-rhs);
 }
 template <std::signed_integral T, std::signed_integral U>
-requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator*(T lhs, const Rational<U>& rhs) noexcept
+requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> operator*(T lhs, const Rational<U>& rhs) noexcept(rational::nothrow_overflow_v<std::common_type_t<T, U>>)
 {
     return rhs * lhs;
 }
@@ -220,3 +275,11 @@ requires std::common_with<T, U> constexpr Rational<std::common_type_t<T, U>> ope
 {
     return lhs * rhs.inverse();
 }
+
+template <std::signed_integral T>
+std::size_t std::hash<Rational<T>>::operator()(const Rational<T>& value) const noexcept
+{
+    const auto numer = std::hash<typename Rational<T>::NumeratorType>{}(value.numer());
+    const auto denom = std::hash<typename Rational<T>::DenominatorType>{}(value.denom());
+    return numer ^ (denom + 0x9e3779b97f4a7c15 + (numer << 6) + (numer >> 2));
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "rational.hpp"
+
+#include <concepts>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+
+namespace rational
+{
+template <class T>
+struct is_rational : std::false_type {
+};
+template <std::signed_integral T>
+struct is_rational<Rational<T>> : std::true_type {
+};
+
+template <class Range>
+concept rational_range = std::ranges::input_range<Range> && is_rational<std::ranges::range_value_t<Range>>::value;
+
+template <rational_range Range>
+using range_numerator_t = typename std::ranges::range_value_t<Range>::NumeratorType;
+}  // namespace rational
+
+namespace rational::detail
+{
+// Exact running sum over a common denominator in the wide type; the numerator and the
+// denominator are only cancelled when the next term would not fit, and once for the result
+template <std::signed_integral T>
+struct Accumulator {
+    using Unsigned = std::make_unsigned_t<T>;
+    using Word = wide_unsigned_t<T>;
+
+    constexpr void add(const Rational<T>&, bool subtract = false) noexcept(nothrow_overflow_v<T>);
+    constexpr void add_product(const Rational<T>&, const Rational<T>&, bool subtract = false) noexcept(nothrow_overflow_v<T>);
+    constexpr void merge(const Accumulator&) noexcept(nothrow_overflow_v<T>);
+
+    constexpr Rational<T> result() const noexcept(nothrow_overflow_v<T>);
+
+private:
+    WideFraction<T> value_{false, 0, 1};
+    // Set once the exact sum outgrows the wide type; later terms follow the operator semantics
+    std::optional<Rational<T>> overflowed_;
+
+    constexpr bool add_exact(bool negative, Unsigned numer, Unsigned denom) noexcept;
+    constexpr bool try_add(bool negative, Unsigned numer, Unsigned denom) noexcept;
+    constexpr bool try_merge(const WideFraction<T>&) noexcept;
+    constexpr bool scaled_add(bool negative, Word numer, Word scale, Word term_scale) noexcept;
+    constexpr void cancel() noexcept;
+    constexpr Rational<T> current() noexcept(nothrow_overflow_v<T>);
+};
+}  // namespace rational::detail
+
+namespace rational
+{
+template <rational_range Range>
+constexpr Rational<range_numerator_t<Range>> sum(Range&&) noexcept(nothrow_overflow_v<range_numerator_t<Range>>);
+
+template <rational_range Lhs, rational_range Rhs>
+requires std::common_with<range_numerator_t<Lhs>, range_numerator_t<Rhs>>
+constexpr auto dot(Lhs&&, Rhs&&) noexcept(nothrow_overflow_v<std::common_type_t<range_numerator_t<Lhs>, range_numerator_t<Rhs>>>)
+    -> Rational<std::common_type_t<range_numerator_t<Lhs>, range_numerator_t<Rhs>>>;
+}  // namespace rational
+
+#include "rational_algorithm.ipp"
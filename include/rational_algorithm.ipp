@@ -0,0 +1,169 @@
+#pragma once
+
+#include "rational_algorithm.hpp"
+#include "rational_gcd.hpp"
+#include "rational_wide.hpp"
+
+#include <iterator>
+#include <limits>
+#include <ranges>
+
+namespace rational::detail
+{
+template <std::signed_integral T>
+constexpr void Accumulator<T>::add(const Rational<T>& value, bool subtract) noexcept(nothrow_overflow_v<T>)
+{
+    if (!overflowed_) {
+        if (add_exact((value.numer_ < 0) != subtract, magnitude(value.numer_), value.denom_)) {
+            return;
+        }
+        overflowed_ = current();
+    }
+    if (subtract) {
+        *overflowed_ -= value;
+    } else {
+        *overflowed_ += value;
+    }
+}
+template <std::signed_integral T>
+constexpr void Accumulator<T>::add_product(const Rational<T>& lhs, const Rational<T>& rhs, bool subtract) noexcept(nothrow_overflow_v<T>)
+{
+    if (!overflowed_) {
+        constexpr auto max = std::numeric_limits<Unsigned>::max();
+
+        // A term of the sum need not be reduced, so the cross cancellation is only done when required
+        auto numer = static_cast<Word>(Word{magnitude(lhs.numer_)} * magnitude(rhs.numer_));
+        auto denom = static_cast<Word>(Word{lhs.denom_} * rhs.denom_);
+        if (numer > max || denom > max) {
+            const auto product = wide_product(lhs.numer_, lhs.denom_, rhs.numer_, rhs.denom_);
+            numer = product.numer;
+            denom = product.denom;
+        }
+        if (numer > max || denom > max) {
+            return add(lhs * rhs, subtract);
+        }
+        if (add_exact(((lhs.numer_ < 0) != (rhs.numer_ < 0)) != subtract, static_cast<Unsigned>(numer), static_cast<Unsigned>(denom))) {
+            return;
+        }
+        overflowed_ = current();
+    }
+    if (subtract) {
+        *overflowed_ -= lhs * rhs;
+    } else {
+        *overflowed_ += lhs * rhs;
+    }
+}
+template <std::signed_integral T>
+constexpr void Accumulator<T>::merge(const Accumulator& other) noexcept(nothrow_overflow_v<T>)
+{
+    if (!overflowed_ && !other.overflowed_) {
+        if (try_merge(other.value_)) {
+            return;
+        }
+        auto reduced = other;
+        reduced.cancel();
+        cancel();
+        if (try_merge(reduced.value_)) {
+            return;
+        }
+    }
+    const auto value = other.result();
+    if (!overflowed_) {
+        overflowed_ = current();
+    }
+    *overflowed_ += value;
+}
+
+template <std::signed_integral T>
+constexpr Rational<T> Accumulator<T>::result() const noexcept(nothrow_overflow_v<T>)
+{
+    if (overflowed_) {
+        return *overflowed_;
+    }
+    auto copy = *this;
+    return copy.current();
+}
+
+template <std::signed_integral T>
+constexpr bool Accumulator<T>::add_exact(bool negative, Unsigned numer, Unsigned denom) noexcept
+{
+    if (try_add(negative, numer, denom)) {
+        return true;
+    }
+    cancel();
+    return try_add(negative, numer, denom);
+}
+template <std::signed_integral T>
+constexpr bool Accumulator<T>::try_add(bool negative, Unsigned numer, Unsigned denom) noexcept
+{
+    // Bring both onto lcm(value_.denom, denom)
+    const auto gcd = binary_gcd(remainder(value_.denom, denom), denom);
+    return scaled_add(negative, numer, static_cast<Unsigned>(denom / gcd), quotient(value_.denom, gcd));
+}
+template <std::signed_integral T>
+constexpr bool Accumulator<T>::try_merge(const WideFraction<T>& other) noexcept
+{
+    const auto gcd = binary_gcd(value_.denom, other.denom);
+    return scaled_add(other.negative, other.numer, static_cast<Word>(other.denom / gcd), static_cast<Word>(value_.denom / gcd));
+}
+template <std::signed_integral T>
+constexpr bool Accumulator<T>::scaled_add(bool negative, Word numer, Word scale, Word term_scale) noexcept
+{
+    Word common, lhs, rhs;
+    if (!checked_multiply(value_.denom, scale, common) || !checked_multiply(value_.numer, scale, lhs) || !checked_multiply(numer, term_scale, rhs)) {
+        return false;
+    }
+    if (value_.negative == negative && static_cast<Word>(lhs + rhs) < lhs) {
+        return false;
+    }
+    value_ = signed_sum<T>(value_.negative, lhs, negative, rhs, common);
+    return true;
+}
+template <std::signed_integral T>
+constexpr void Accumulator<T>::cancel() noexcept
+{
+    const auto gcd = binary_gcd(value_.numer, value_.denom);
+    if (gcd > 1) {
+        value_.numer = static_cast<Word>(value_.numer / gcd);
+        value_.denom = static_cast<Word>(value_.denom / gcd);
+    }
+}
+template <std::signed_integral T>
+constexpr Rational<T> Accumulator<T>::current() noexcept(nothrow_overflow_v<T>)
+{
+    cancel();
+    T numer;
+    Unsigned denom;
+    narrow(value_, numer, denom);
+    return Rational<T>{Rational<T>::simple_copy_, numer, denom};
+}
+}  // namespace rational::detail
+
+namespace rational
+{
+template <rational_range Range>
+constexpr Rational<range_numerator_t<Range>> sum(Range&& range) noexcept(nothrow_overflow_v<range_numerator_t<Range>>)
+{
+    detail::Accumulator<range_numerator_t<Range>> accumulator;
+    for (const auto& value : range) {
+        accumulator.add(value);
+    }
+    return accumulator.result();
+}
+
+template <rational_range Lhs, rational_range Rhs>
+requires std::common_with<range_numerator_t<Lhs>, range_numerator_t<Rhs>>
+constexpr auto dot(Lhs&& lhs, Rhs&& rhs) noexcept(nothrow_overflow_v<std::common_type_t<range_numerator_t<Lhs>, range_numerator_t<Rhs>>>)
+    -> Rational<std::common_type_t<range_numerator_t<Lhs>, range_numerator_t<Rhs>>>
+{
+    using ResultType = Rational<std::common_type_t<range_numerator_t<Lhs>, range_numerator_t<Rhs>>>;
+
+    detail::Accumulator<typename ResultType::NumeratorType> accumulator;
+    auto lhs_it = std::ranges::begin(lhs);
+    auto rhs_it = std::ranges::begin(rhs);
+    for (; lhs_it != std::ranges::end(lhs) && rhs_it != std::ranges::end(rhs); ++lhs_it, ++rhs_it) {
+        accumulator.add_product(static_cast<ResultType>(*lhs_it), static_cast<ResultType>(*rhs_it));
+    }
+    return accumulator.result();
+}
+}  // namespace rational
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "rational.hpp"
+#include "rational_simd.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+template <std::signed_integral T>
+struct RationalArray {
+    using value_type = Rational<T>;
+    using NumeratorType = T;
+    using DenominatorType = std::make_unsigned_t<T>;
+    using Mask = std::vector<std::uint8_t>;
+
+    RationalArray() = default;
+    explicit RationalArray(std::size_t, const Rational<T>& = Rational<T>{0});
+    RationalArray(std::initializer_list<Rational<T>>);
+    template <std::input_iterator Iterator>
+    RationalArray(Iterator, Iterator);
+
+    std::size_t size() const noexcept { return numer_.size(); }
+    bool empty() const noexcept { return numer_.empty(); }
+    void reserve(std::size_t);
+    void resize(std::size_t, const Rational<T>& = Rational<T>{0});
+    void clear() noexcept;
+    void push_back(const Rational<T>&);
+
+    Rational<T> operator[](std::size_t) const noexcept;
+    void set(std::size_t, const Rational<T>&) noexcept;
+
+    std::span<NumeratorType> numers() noexcept { return numer_; }
+    std::span<const NumeratorType> numers() const noexcept { return numer_; }
+    std::span<DenominatorType> denoms() noexcept { return denom_; }
+    std::span<const DenominatorType> denoms() const noexcept { return denom_; }
+
+    RationalArray& operator+=(const RationalArray&);
+    RationalArray& operator-=(const RationalArray&);
+    RationalArray& operator*=(const RationalArray&);
+    RationalArray& operator/=(const RationalArray&);
+
+    RationalArray& operator*=(T);
+
+    RationalArray& reduction() noexcept;
+
+private:
+    template <class U>
+    using Storage = std::vector<U, rational::detail::AlignedAllocator<U>>;
+
+    Storage<NumeratorType> numer_;
+    Storage<DenominatorType> denom_;
+
+    constexpr static bool vectorized_ = sizeof(T) <= sizeof(std::int32_t);
+
+    void check_size(const RationalArray&) const;
+    template <class Widen, class Fallback>
+    void transform(Widen, Fallback);
+};
+
+template <std::signed_integral T>
+RationalArray<T> operator+(const RationalArray<T>&, const RationalArray<T>&);
+template <std::signed_integral T>
+RationalArray<T> operator-(const RationalArray<T>&, const RationalArray<T>&);
+template <std::signed_integral T>
+RationalArray<T> operator*(const RationalArray<T>&, const RationalArray<T>&);
+template <std::signed_integral T>
+RationalArray<T> operator/(const RationalArray<T>&, const RationalArray<T>&);
+
+template <std::signed_integral T>
+RationalArray<T> operator*(const RationalArray<T>&, T);
+template <std::signed_integral T>
+RationalArray<T> operator*(T, const RationalArray<T>&);
+
+template <std::signed_integral T>
+typename RationalArray<T>::Mask operator==(const RationalArray<T>&, const RationalArray<T>&);
+template <std::signed_integral T>
+typename RationalArray<T>::Mask operator!=(const RationalArray<T>&, const RationalArray<T>&);
+template <std::signed_integral T>
+typename RationalArray<T>::Mask operator<(const RationalArray<T>&, const RationalArray<T>&);
+template <std::signed_integral T>
+typename RationalArray<T>::Mask operator>(const RationalArray<T>&, const RationalArray<T>&);
+template <std::signed_integral T>
+typename RationalArray<T>::Mask operator<=(const RationalArray<T>&, const RationalArray<T>&);
+template <std::signed_integral T>
+typename RationalArray<T>::Mask operator>=(const RationalArray<T>&, const RationalArray<T>&);
+
+#include "rational_array.ipp"
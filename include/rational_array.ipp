@@ -0,0 +1,372 @@
+#pragma once
+
+#include "rational_array.hpp"
+#include "rational_gcd.hpp"
+#include "rational_simd.hpp"
+#include "rational_wide.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+namespace rational::detail
+{
+template <std::signed_integral T>
+constexpr bool fits(std::int64_t numer, std::uint64_t denom) noexcept
+{
+    return numer >= std::numeric_limits<T>::min() && numer <= std::numeric_limits<T>::max()
+           && denom <= std::numeric_limits<std::make_unsigned_t<T>>::max();
+}
+
+// Each element is computed exactly in 64 bits by widen, reduced a block at a time, and narrowed back;
+// elements that do not fit are left to fallback, which applies the scalar Rational<T> operation
+template <SimdLevel Level, std::signed_integral T, class Widen, class Fallback>
+[[gnu::always_inline]] inline void transform_rational(T* numer, std::make_unsigned_t<T>* denom, std::size_t size, Widen& widen, Fallback& fallback)
+{
+    constexpr std::size_t block = 256;
+    alignas(64) std::int64_t wide_numer[block];
+    alignas(64) std::uint64_t wide_denom[block];
+    bool valid[block];
+
+    for (std::size_t begin = 0; begin < size; begin += block) {
+        const auto count = std::min(block, size - begin);
+        for (std::size_t i = 0; i < count; ++i) {
+            valid[i] = widen(begin + i, wide_numer[i], wide_denom[i]);
+            wide_denom[i] = valid[i] ? wide_denom[i] : 1;
+        }
+#if RATIONAL_X86_SIMD
+        if constexpr (Level == SimdLevel::avx512) {
+            reduce_wide_avx512(wide_numer, wide_denom, count);
+        } else if constexpr (Level == SimdLevel::avx2) {
+            reduce_wide_avx2(wide_numer, wide_denom, count);
+        } else {
+            reduce_wide_scalar(wide_numer, wide_denom, count);
+        }
+#else
+        reduce_wide_scalar(wide_numer, wide_denom, count);
+#endif
+        for (std::size_t i = 0; i < count; ++i) {
+            if (valid[i] && fits<T>(wide_numer[i], wide_denom[i])) [[likely]] {
+                numer[begin + i] = static_cast<T>(wide_numer[i]);
+                denom[begin + i] = static_cast<std::make_unsigned_t<T>>(wide_denom[i]);
+            } else {
+                fallback(begin + i);
+            }
+        }
+    }
+}
+
+template <std::signed_integral T, class Predicate>
+[[gnu::always_inline]] inline void compare_rational(const T* lhs_numer, const std::make_unsigned_t<T>* lhs_denom, const T* rhs_numer, const std::make_unsigned_t<T>* rhs_denom,
+    std::uint8_t* mask, std::size_t size, Predicate predicate)
+{
+    using Wide = wide_signed_t<T>;
+    for (std::size_t i = 0; i < size; ++i) {
+        mask[i] = predicate(static_cast<Wide>(Wide{lhs_numer[i]} * Wide{rhs_denom[i]}), static_cast<Wide>(Wide{rhs_numer[i]} * Wide{lhs_denom[i]})) ? 1 : 0;
+    }
+}
+
+#if RATIONAL_X86_SIMD
+template <std::signed_integral T, class Widen, class Fallback>
+[[RATIONAL_TARGET_AVX512, gnu::flatten]] void transform_rational_avx512(T* numer, std::make_unsigned_t<T>* denom, std::size_t size, Widen& widen, Fallback& fallback)
+{
+    transform_rational<SimdLevel::avx512>(numer, denom, size, widen, fallback);
+}
+template <std::signed_integral T, class Widen, class Fallback>
+[[RATIONAL_TARGET_AVX2, gnu::flatten]] void transform_rational_avx2(T* numer, std::make_unsigned_t<T>* denom, std::size_t size, Widen& widen, Fallback& fallback)
+{
+    transform_rational<SimdLevel::avx2>(numer, denom, size, widen, fallback);
+}
+template <std::signed_integral T, class Predicate>
+[[RATIONAL_TARGET_AVX512, gnu::flatten]] void compare_rational_avx512(const T* lhs_numer, const std::make_unsigned_t<T>* lhs_denom, const T* rhs_numer, const std::make_unsigned_t<T>* rhs_denom,
+    std::uint8_t* mask, std::size_t size, Predicate predicate)
+{
+    compare_rational(lhs_numer, lhs_denom, rhs_numer, rhs_denom, mask, size, predicate);
+}
+template <std::signed_integral T, class Predicate>
+[[RATIONAL_TARGET_AVX2, gnu::flatten]] void compare_rational_avx2(const T* lhs_numer, const std::make_unsigned_t<T>* lhs_denom, const T* rhs_numer, const std::make_unsigned_t<T>* rhs_denom,
+    std::uint8_t* mask, std::size_t size, Predicate predicate)
+{
+    compare_rational(lhs_numer, lhs_denom, rhs_numer, rhs_denom, mask, size, predicate);
+}
+#endif
+
+template <std::signed_integral T, class Widen, class Fallback>
+void transform_rational(SimdLevel level, T* numer, std::make_unsigned_t<T>* denom, std::size_t size, Widen& widen, Fallback& fallback)
+{
+    switch (level) {
+#if RATIONAL_X86_SIMD
+    case SimdLevel::avx512:
+        return transform_rational_avx512(numer, denom, size, widen, fallback);
+    case SimdLevel::avx2:
+        return transform_rational_avx2(numer, denom, size, widen, fallback);
+#endif
+    default:
+        return transform_rational<SimdLevel::scalar>(numer, denom, size, widen, fallback);
+    }
+}
+
+template <std::signed_integral T, class Predicate>
+typename RationalArray<T>::Mask compare_rational(const RationalArray<T>& lhs, const RationalArray<T>& rhs, Predicate predicate)
+{
+    if (lhs.size() != rhs.size()) {
+        throw std::invalid_argument{"sizes of RationalArray differ"};
+    }
+    typename RationalArray<T>::Mask mask(lhs.size());
+    const auto lhs_numer = lhs.numers().data(), rhs_numer = rhs.numers().data();
+    const auto lhs_denom = lhs.denoms().data(), rhs_denom = rhs.denoms().data();
+    switch (simd_level()) {
+#if RATIONAL_X86_SIMD
+    case SimdLevel::avx512:
+        compare_rational_avx512(lhs_numer, lhs_denom, rhs_numer, rhs_denom, mask.data(), mask.size(), predicate);
+        break;
+    case SimdLevel::avx2:
+        compare_rational_avx2(lhs_numer, lhs_denom, rhs_numer, rhs_denom, mask.data(), mask.size(), predicate);
+        break;
+#endif
+    default:
+        compare_rational(lhs_numer, lhs_denom, rhs_numer, rhs_denom, mask.data(), mask.size(), predicate);
+        break;
+    }
+    return mask;
+}
+
+constexpr bool add_overflows(std::int64_t lhs, std::int64_t rhs) noexcept
+{
+    return rhs > 0 ? lhs > std::numeric_limits<std::int64_t>::max() - rhs : lhs < std::numeric_limits<std::int64_t>::min() - rhs;
+}
+}  // namespace rational::detail
+
+template <std::signed_integral T>
+RationalArray<T>::RationalArray(std::size_t size, const Rational<T>& value) : numer_(size, value.numer()), denom_(size, value.denom())
+{
+}
+template <std::signed_integral T>
+RationalArray<T>::RationalArray(std::initializer_list<Rational<T>> values) : RationalArray{values.begin(), values.end()}
+{
+}
+template <std::signed_integral T>
+template <std::input_iterator Iterator>
+RationalArray<T>::RationalArray(Iterator first, Iterator last)
+{
+    for (; first != last; ++first) {
+        push_back(*first);
+    }
+}
+
+template <std::signed_integral T>
+void RationalArray<T>::reserve(std::size_t size)
+{
+    numer_.reserve(size);
+    denom_.reserve(size);
+}
+template <std::signed_integral T>
+void RationalArray<T>::resize(std::size_t size, const Rational<T>& value)
+{
+    numer_.resize(size, value.numer());
+    denom_.resize(size, value.denom());
+}
+template <std::signed_integral T>
+void RationalArray<T>::clear() noexcept
+{
+    numer_.clear();
+    denom_.clear();
+}
+template <std::signed_integral T>
+void RationalArray<T>::push_back(const Rational<T>& value)
+{
+    numer_.push_back(value.numer());
+    denom_.push_back(value.denom());
+}
+
+template <std::signed_integral T>
+Rational<T> RationalArray<T>::operator[](std::size_t index) const noexcept
+{
+    return Rational<T>{Rational<T>::simple_copy_, numer_[index], denom_[index]};
+}
+template <std::signed_integral T>
+void RationalArray<T>::set(std::size_t index, const Rational<T>& value) noexcept
+{
+    numer_[index] = value.numer();
+    denom_[index] = value.denom();
+}
+
+template <std::signed_integral T>
+void RationalArray<T>::check_size(const RationalArray& other) const
+{
+    if (size() != other.size()) {
+        throw std::invalid_argument{"sizes of RationalArray differ"};
+    }
+}
+template <std::signed_integral T>
+template <class Widen, class Fallback>
+void RationalArray<T>::transform(Widen widen, Fallback fallback)
+{
+    if constexpr (vectorized_) {
+        rational::detail::transform_rational(rational::detail::simd_level(), numer_.data(), denom_.data(), size(), widen, fallback);
+    } else {
+        for (std::size_t i = 0; i < size(); ++i) {
+            fallback(i);
+        }
+    }
+}
+
+template <std::signed_integral T>
+auto RationalArray<T>::operator+=(const RationalArray& other) -> RationalArray&
+{
+    check_size(other);
+    transform(
+        [&](std::size_t i, std::int64_t& numer, std::uint64_t& denom) {
+            const auto lhs = std::int64_t{numer_[i]} * other.denom_[i], rhs = std::int64_t{other.numer_[i]} * denom_[i];
+            numer = static_cast<std::int64_t>(static_cast<std::uint64_t>(lhs) + static_cast<std::uint64_t>(rhs));
+            denom = std::uint64_t{denom_[i]} * other.denom_[i];
+            return !rational::detail::add_overflows(lhs, rhs);
+        },
+        [&](std::size_t i) { set(i, (*this)[i] += other[i]); });
+    return *this;
+}
+template <std::signed_integral T>
+auto RationalArray<T>::operator-=(const RationalArray& other) -> RationalArray&
+{
+    check_size(other);
+    transform(
+        [&](std::size_t i, std::int64_t& numer, std::uint64_t& denom) {
+            const auto lhs = std::int64_t{numer_[i]} * other.denom_[i], rhs = -(std::int64_t{other.numer_[i]} * denom_[i]);
+            numer = static_cast<std::int64_t>(static_cast<std::uint64_t>(lhs) + static_cast<std::uint64_t>(rhs));
+            denom = std::uint64_t{denom_[i]} * other.denom_[i];
+            return !rational::detail::add_overflows(lhs, rhs);
+        },
+        [&](std::size_t i) { set(i, (*this)[i] -= other[i]); });
+    return *this;
+}
+template <std::signed_integral T>
+auto RationalArray<T>::operator*=(const RationalArray& other) -> RationalArray&
+{
+    check_size(other);
+    transform(
+        [&](std::size_t i, std::int64_t& numer, std::uint64_t& denom) {
+            numer = std::int64_t{numer_[i]} * other.numer_[i];
+            denom = std::uint64_t{denom_[i]} * other.denom_[i];
+            return true;
+        },
+        [&](std::size_t i) { set(i, (*this)[i] *= other[i]); });
+    return *this;
+}
+template <std::signed_integral T>
+auto RationalArray<T>::operator/=(const RationalArray& other) -> RationalArray&
+{
+    check_size(other);
+    transform(
+        [&](std::size_t i, std::int64_t& numer, std::uint64_t& denom) {
+            const auto divisor = other.numer_[i];
+            numer = std::int64_t{numer_[i]} * other.denom_[i];
+            numer = divisor < 0 ? -numer : numer;
+            denom = std::uint64_t{denom_[i]} * rational::detail::magnitude(divisor);
+            return divisor != 0;
+        },
+        [&](std::size_t i) { set(i, (*this)[i] /= other[i]); });
+    return *this;
+}
+
+template <std::signed_integral T>
+auto RationalArray<T>::operator*=(T other) -> RationalArray&
+{
+    transform(
+        [&](std::size_t i, std::int64_t& numer, std::uint64_t& denom) {
+            numer = std::int64_t{numer_[i]} * other;
+            denom = denom_[i];
+            return true;
+        },
+        [&](std::size_t i) { set(i, (*this)[i] *= other); });
+    return *this;
+}
+
+template <std::signed_integral T>
+auto RationalArray<T>::reduction() noexcept -> RationalArray&
+{
+    transform(
+        [&](std::size_t i, std::int64_t& numer, std::uint64_t& denom) {
+            numer = numer_[i];
+            denom = denom_[i];
+            return denom != 0;
+        },
+        [&](std::size_t i) { rational::detail::reduce(numer_[i], denom_[i]); });
+    return *this;
+}
+
+template <std::signed_integral T>
+RationalArray<T> operator+(const RationalArray<T>& lhs, const RationalArray<T>& rhs)
+{
+    RationalArray<T> result{lhs};
+    result += rhs;
+    return result;
+}
+template <std::signed_integral T>
+RationalArray<T> operator-(const RationalArray<T>& lhs, const RationalArray<T>& rhs)
+{
+    RationalArray<T> result{lhs};
+    result -= rhs;
+    return result;
+}
+template <std::signed_integral T>
+RationalArray<T> operator*(const RationalArray<T>& lhs, const RationalArray<T>& rhs)
+{
+    RationalArray<T> result{lhs};
+    result *= rhs;
+    return result;
+}
+template <std::signed_integral T>
+RationalArray<T> operator/(const RationalArray<T>& lhs, const RationalArray<T>& rhs)
+{
+    RationalArray<T> result{lhs};
+    result /= rhs;
+    return result;
+}
+
+template <std::signed_integral T>
+RationalArray<T> operator*(const RationalArray<T>& lhs, T rhs)
+{
+    RationalArray<T> result{lhs};
+    result *= rhs;
+    return result;
+}
+template <std::signed_integral T>
+RationalArray<T> operator*(T lhs, const RationalArray<T>& rhs)
+{
+    return rhs * lhs;
+}
+
+template <std::signed_integral T>
+typename RationalArray<T>::Mask operator==(const RationalArray<T>& lhs, const RationalArray<T>& rhs)
+{
+    return rational::detail::compare_rational(lhs, rhs, std::equal_to<>{});
+}
+template <std::signed_integral T>
+typename RationalArray<T>::Mask operator!=(const RationalArray<T>& lhs, const RationalArray<T>& rhs)
+{
+    return rational::detail::compare_rational(lhs, rhs, std::not_equal_to<>{});
+}
+template <std::signed_integral T>
+typename RationalArray<T>::Mask operator<(const RationalArray<T>& lhs, const RationalArray<T>& rhs)
+{
+    return rational::detail::compare_rational(lhs, rhs, std::less<>{});
+}
+template <std::signed_integral T>
+typename RationalArray<T>::Mask operator>(const RationalArray<T>& lhs, const RationalArray<T>& rhs)
+{
+    return rational::detail::compare_rational(lhs, rhs, std::greater<>{});
+}
+template <std::signed_integral T>
+typename RationalArray<T>::Mask operator<=(const RationalArray<T>& lhs, const RationalArray<T>& rhs)
+{
+    return rational::detail::compare_rational(lhs, rhs, std::less_equal<>{});
+}
+template <std::signed_integral T>
+typename RationalArray<T>::Mask operator>=(const RationalArray<T>& lhs, const RationalArray<T>& rhs)
+{
+    return rational::detail::compare_rational(lhs, rhs, std::greater_equal<>{});
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "rational.hpp"
+#include "rational_algorithm.hpp"
+
+#include <concepts>
+#include <type_traits>
+
+namespace rational
+{
+// Opt-in expression templates: sums of products built from expr(x) are evaluated in a
+// single Accumulator and reduced once, instead of once per operator. Only products that start
+// from expr(x) are fused; in expr(a) * b + c * d, c * d is an ordinary Rational product and is
+// reduced before it joins the sum, so write expr(a) * b + expr(c) * d
+template <std::signed_integral T>
+struct Term {
+    using NumeratorType = T;
+
+    Rational<T> value;
+
+    constexpr operator Rational<T>() const noexcept { return value; }
+};
+
+template <class Lhs, class Rhs>
+struct ProductExpression {
+    using NumeratorType = std::common_type_t<typename Lhs::NumeratorType, typename Rhs::NumeratorType>;
+
+    Lhs lhs;
+    Rhs rhs;
+
+    constexpr operator Rational<NumeratorType>() const noexcept(nothrow_overflow_v<NumeratorType>);
+};
+
+template <class Lhs, class Rhs, bool Subtract>
+struct SumExpression {
+    using NumeratorType = std::common_type_t<typename Lhs::NumeratorType, typename Rhs::NumeratorType>;
+
+    Lhs lhs;
+    Rhs rhs;
+
+    constexpr operator Rational<NumeratorType>() const noexcept(nothrow_overflow_v<NumeratorType>);
+};
+
+template <class E>
+struct is_expression : std::false_type {
+};
+template <std::signed_integral T>
+struct is_expression<Term<T>> : std::true_type {
+};
+template <class Lhs, class Rhs>
+struct is_expression<ProductExpression<Lhs, Rhs>> : std::true_type {
+};
+template <class Lhs, class Rhs, bool Subtract>
+struct is_expression<SumExpression<Lhs, Rhs, Subtract>> : std::true_type {
+};
+
+template <class E>
+concept expression = is_expression<E>::value;
+
+template <std::signed_integral T>
+constexpr Term<T> expr(const Rational<T>&) noexcept;
+
+template <expression E>
+constexpr Rational<typename E::NumeratorType> evaluate(const E&) noexcept(nothrow_overflow_v<typename E::NumeratorType>);
+
+template <expression Lhs, expression Rhs>
+constexpr SumExpression<Lhs, Rhs, false> operator+(const Lhs&, const Rhs&) noexcept;
+template <expression Lhs, std::signed_integral T>
+constexpr SumExpression<Lhs, Term<T>, false> operator+(const Lhs&, const Rational<T>&) noexcept;
+template <std::signed_integral T, expression Rhs>
+constexpr SumExpression<Term<T>, Rhs, false> operator+(const Rational<T>&, const Rhs&) noexcept;
+
+template <expression Lhs, expression Rhs>
+constexpr SumExpression<Lhs, Rhs, true> operator-(const Lhs&, const Rhs&) noexcept;
+template <expression Lhs, std::signed_integral T>
+constexpr SumExpression<Lhs, Term<T>, true> operator-(const Lhs&, const Rational<T>&) noexcept;
+template <std::signed_integral T, expression Rhs>
+constexpr SumExpression<Term<T>, Rhs, true> operator-(const Rational<T>&, const Rhs&) noexcept;
+
+template <expression Lhs, expression Rhs>
+constexpr ProductExpression<Lhs, Rhs> operator*(const Lhs&, const Rhs&) noexcept;
+template <expression Lhs, std::signed_integral T>
+constexpr ProductExpression<Lhs, Term<T>> operator*(const Lhs&, const Rational<T>&) noexcept;
+template <std::signed_integral T, expression Rhs>
+constexpr ProductExpression<Term<T>, Rhs> operator*(const Rational<T>&, const Rhs&) noexcept;
+}  // namespace rational
+
+#include "rational_expression.ipp"
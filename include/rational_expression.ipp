@@ -0,0 +1,106 @@
+#pragma once
+
+#include "rational_algorithm.hpp"
+#include "rational_expression.hpp"
+
+namespace rational::detail
+{
+template <std::signed_integral T, expression E>
+constexpr Rational<T> evaluate_as(const E& value) noexcept(nothrow_overflow_v<T>)
+{
+    return rational::evaluate(value);
+}
+
+template <std::signed_integral T, std::signed_integral U>
+constexpr void accumulate(Accumulator<T>& accumulator, const Term<U>& term, bool subtract) noexcept(nothrow_overflow_v<T>)
+{
+    accumulator.add(term.value, subtract);
+}
+template <std::signed_integral T, class Lhs, class Rhs>
+constexpr void accumulate(Accumulator<T>& accumulator, const ProductExpression<Lhs, Rhs>& product, bool subtract) noexcept(nothrow_overflow_v<T>)
+{
+    accumulator.add_product(evaluate_as<T>(product.lhs), evaluate_as<T>(product.rhs), subtract);
+}
+template <std::signed_integral T, class Lhs, class Rhs, bool Subtract>
+constexpr void accumulate(Accumulator<T>& accumulator, const SumExpression<Lhs, Rhs, Subtract>& sum, bool subtract) noexcept(nothrow_overflow_v<T>)
+{
+    accumulate(accumulator, sum.lhs, subtract);
+    accumulate(accumulator, sum.rhs, subtract != Subtract);
+}
+}  // namespace rational::detail
+
+namespace rational
+{
+template <class Lhs, class Rhs>
+constexpr ProductExpression<Lhs, Rhs>::operator Rational<NumeratorType>() const noexcept(nothrow_overflow_v<NumeratorType>)
+{
+    return detail::evaluate_as<NumeratorType>(lhs) * detail::evaluate_as<NumeratorType>(rhs);
+}
+template <class Lhs, class Rhs, bool Subtract>
+constexpr SumExpression<Lhs, Rhs, Subtract>::operator Rational<NumeratorType>() const noexcept(nothrow_overflow_v<NumeratorType>)
+{
+    detail::Accumulator<NumeratorType> accumulator;
+    detail::accumulate(accumulator, *this, false);
+    return accumulator.result();
+}
+
+template <std::signed_integral T>
+constexpr Term<T> expr(const Rational<T>& value) noexcept
+{
+    return {value};
+}
+
+template <expression E>
+constexpr Rational<typename E::NumeratorType> evaluate(const E& value) noexcept(nothrow_overflow_v<typename E::NumeratorType>)
+{
+    return value;
+}
+
+template <expression Lhs, expression Rhs>
+constexpr SumExpression<Lhs, Rhs, false> operator+(const Lhs& lhs, const Rhs& rhs) noexcept
+{
+    return {lhs, rhs};
+}
+template <expression Lhs, std::signed_integral T>
+constexpr SumExpression<Lhs, Term<T>, false> operator+(const Lhs& lhs, const Rational<T>& rhs) noexcept
+{
+    return {lhs, {rhs}};
+}
+template <std::signed_integral T, expression Rhs>
+constexpr SumExpression<Term<T>, Rhs, false> operator+(const Rational<T>& lhs, const Rhs& rhs) noexcept
+{
+    return {{lhs}, rhs};
+}
+
+template <expression Lhs, expression Rhs>
+constexpr SumExpression<Lhs, Rhs, true> operator-(const Lhs& lhs, const Rhs& rhs) noexcept
+{
+    return {lhs, rhs};
+}
+template <expression Lhs, std::signed_integral T>
+constexpr SumExpression<Lhs, Term<T>, true> operator-(const Lhs& lhs, const Rational<T>& rhs) noexcept
+{
+    return {lhs, {rhs}};
+}
+template <std::signed_integral T, expression Rhs>
+constexpr SumExpression<Term<T>, Rhs, true> operator-(const Rational<T>& lhs, const Rhs& rhs) noexcept
+{
+    return {{lhs}, rhs};
+}
+
+template <expression Lhs, expression Rhs>
+constexpr ProductExpression<Lhs, Rhs> operator*(const Lhs& lhs, const Rhs& rhs) noexcept
+{
+    return {lhs, rhs};
+}
+template <expression Lhs, std::signed_integral T>
+constexpr ProductExpression<Lhs, Term<T>> operator*(const Lhs& lhs, const Rational<T>& rhs) noexcept
+{
+    return {lhs, {rhs}};
+}
+template <std::signed_integral T, expression Rhs>
+constexpr ProductExpression<Term<T>, Rhs> operator*(const Rational<T>& lhs, const Rhs& rhs) noexcept
+{
+    return {{lhs}, rhs};
+}
+}  // namespace rational
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "rational_gcd.hpp"
+#include "rational_wide.hpp"
+
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace rational::detail
+{
+template <class F>
+concept binary_floating = (std::same_as<F, float> || std::same_as<F, double>) && std::numeric_limits<F>::is_iec559;
+
+template <binary_floating F>
+using floating_bits_t = std::conditional_t<sizeof(F) == sizeof(std::uint32_t), std::uint32_t, std::uint64_t>;
+
+// value == (negative ? -1 : 1) * mantissa * 2^exponent
+struct FloatingParts {
+    bool finite;
+    bool negative;
+    std::uint64_t mantissa;
+    int exponent;
+};
+
+template <binary_floating F>
+constexpr FloatingParts decompose(F value) noexcept
+{
+    using Bits = floating_bits_t<F>;
+    constexpr int fraction_bits = std::numeric_limits<F>::digits - 1;
+    constexpr int bias = std::numeric_limits<F>::max_exponent - 1;
+    constexpr auto exponent_mask = static_cast<Bits>(2 * bias + 1);
+
+    const auto bits = std::bit_cast<Bits>(value);
+    const bool negative = bits >> (std::numeric_limits<Bits>::digits - 1) != 0;
+    const auto biased = static_cast<int>((bits >> fraction_bits) & exponent_mask);
+    const auto fraction = static_cast<std::uint64_t>(bits & ((Bits{1} << fraction_bits) - 1));
+    if (biased == 0) {
+        return {true, negative, fraction, 1 - bias - fraction_bits};
+    }
+    return {biased != exponent_mask, negative, fraction | std::uint64_t{1} << fraction_bits, biased - bias - fraction_bits};
+}
+
+// 2^exponent, for exponents in the normal range
+template <binary_floating F>
+constexpr F exp2(int exponent) noexcept
+{
+    using Bits = floating_bits_t<F>;
+    constexpr int bias = std::numeric_limits<F>::max_exponent - 1;
+    return std::bit_cast<F>(static_cast<Bits>(static_cast<Bits>(exponent + bias) << (std::numeric_limits<F>::digits - 1)));
+}
+
+// numer / denom rounded once, to nearest even
+template <binary_floating F, std::signed_integral T>
+constexpr F to_floating(T numer, std::make_unsigned_t<T> denom) noexcept
+{
+    using Unsigned = std::make_unsigned_t<T>;
+    constexpr int digits = std::numeric_limits<F>::digits;
+
+    const auto abs = magnitude(numer);
+    if constexpr (std::numeric_limits<Unsigned>::digits > digits) {
+        if (abs != 0 && (bit_width(abs) > digits || bit_width(denom) > digits)) {
+            using Word = wide_unsigned_t<T>;
+
+            if (std::has_single_bit(denom)) {
+                // only the conversion of the numerator rounds
+                const auto value = static_cast<F>(abs) * exp2<F>(1 - bit_width(denom));
+                return numer < 0 ? -value : value;
+            }
+
+            // the quotient to digits + 1 or digits + 2 bits, and whether anything is left below
+            const int shift = digits + 1 - bit_width(abs) + bit_width(denom);
+            Word scaled_quotient;
+            bool sticky;
+            if (shift >= 0) {
+                const auto scaled = static_cast<Word>(Word{abs} << shift);
+                scaled_quotient = quotient(scaled, denom);
+                sticky = scaled_quotient * denom != scaled;
+            } else {
+                const auto scaled = static_cast<Unsigned>(denom << -shift);
+                scaled_quotient = abs / scaled;
+                sticky = abs % scaled != 0;
+            }
+
+            const int extra = bit_width(scaled_quotient) - digits;
+            const auto half = static_cast<Word>(Word{1} << (extra - 1));
+            const auto rest = static_cast<Word>(scaled_quotient & ((Word{1} << extra) - 1));
+            auto mantissa = static_cast<std::uint64_t>(scaled_quotient >> extra);
+            if (rest > half || (rest == half && (sticky || (mantissa & 1) != 0))) {
+                ++mantissa;
+            }
+            const auto value = static_cast<F>(mantissa) * exp2<F>(extra - shift);
+            return numer < 0 ? -value : value;
+        }
+    }
+    // both operands are exact, so the division is the only rounding
+    const auto value = static_cast<F>(abs) / static_cast<F>(denom);
+    return numer < 0 ? -value : value;
+}
+}  // namespace rational::detail
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
+
+namespace rational::detail
+{
+__extension__ typedef __int128 int128_t;
+__extension__ typedef unsigned __int128 uint128_t;
+
+template <class U>
+concept unsigned_word = std::unsigned_integral<U> || std::same_as<U, uint128_t>;
+
+template <unsigned_word U>
+constexpr int countr_zero(U value) noexcept
+{
+    if constexpr (std::same_as<U, uint128_t>) {
+        const auto low = static_cast<std::uint64_t>(value);
+        return low != 0 ? std::countr_zero(low) : 64 + std::countr_zero(static_cast<std::uint64_t>(value >> 64));
+    } else {
+        return std::countr_zero(value);
+    }
+}
+template <unsigned_word U>
+constexpr int bit_width(U value) noexcept
+{
+    if constexpr (std::same_as<U, uint128_t>) {
+        const auto high = static_cast<std::uint64_t>(value >> 64);
+        return high != 0 ? 64 + static_cast<int>(std::bit_width(high)) : static_cast<int>(std::bit_width(static_cast<std::uint64_t>(value)));
+    } else {
+        return static_cast<int>(std::bit_width(value));
+    }
+}
+
+template <unsigned_word U>
+using gcd_word_t = std::conditional_t<(sizeof(U) < sizeof(unsigned int)), unsigned int, U>;
+
+template <unsigned_word U>
+constexpr U binary_gcd(U lhs, U rhs) noexcept
+{
+    using Word = gcd_word_t<U>;
+    Word u = lhs, v = rhs;
+    if (u == 0) {
+        return rhs;
+    }
+    if (v == 0) {
+        return lhs;
+    }
+
+    auto u_zeros = countr_zero(u);
+    const auto v_zeros = countr_zero(v);
+    const auto shift = u_zeros < v_zeros ? u_zeros : v_zeros;
+    v >>= v_zeros;
+    while (u != 0) {
+        u >>= u_zeros;
+        u_zeros = countr_zero(static_cast<Word>(v - u));
+        const auto smaller = u < v ? u : v;
+        u = u < v ? v - u : u - v;
+        v = smaller;
+    }
+    return static_cast<U>(v << shift);
+}
+
+template <std::signed_integral T>
+constexpr std::make_unsigned_t<T> magnitude(T value) noexcept
+{
+    using U = std::make_unsigned_t<T>;
+    return static_cast<U>(value < 0 ? U{0} - static_cast<U>(value) : static_cast<U>(value));
+}
+
+template <std::signed_integral T>
+constexpr int bit_width(T value) noexcept
+{
+    return bit_width(magnitude(value));
+}
+
+template <std::signed_integral T>
+constexpr T with_sign(bool negative, std::make_unsigned_t<T> magnitude) noexcept
+{
+    using U = std::make_unsigned_t<T>;
+    return static_cast<T>(negative ? static_cast<U>(U{0} - magnitude) : magnitude);
+}
+
+template <std::signed_integral T>
+constexpr T divide(T value, std::make_unsigned_t<T> divisor) noexcept
+{
+    return with_sign<T>(value < 0, static_cast<std::make_unsigned_t<T>>(magnitude(value) / divisor));
+}
+
+template <std::signed_integral T>
+constexpr void reduce(T& numer, std::make_unsigned_t<T>& denom) noexcept
+{
+    if (denom == 1) {
+        return;
+    }
+    const auto gcd = binary_gcd(magnitude(numer), denom);
+    if (gcd > 1) {
+        numer = divide(numer, gcd);
+        denom = static_cast<std::make_unsigned_t<T>>(denom / gcd);
+    }
+}
+}  // namespace rational::detail
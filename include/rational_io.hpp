@@ -0,0 +1,89 @@
+#pragma once
+
+#include "rational.hpp"
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <version>
+
+#if defined(__cpp_lib_format)
+#include <format>
+#include <string_view>
+#endif
+
+namespace rational
+{
+// Longest output of to_chars: "-n/d"
+template <std::signed_integral T>
+constexpr std::size_t max_chars = std::numeric_limits<T>::digits10 + 1 + 1 + 1 + std::numeric_limits<std::make_unsigned_t<T>>::digits10 + 1;
+
+// "n" when the denominator is 1, "n/d" otherwise
+template <std::signed_integral T>
+std::to_chars_result to_chars(char*, char*, const Rational<T>&) noexcept;
+
+// Accepts "n/d", "n" and decimal literals like "-12.50" or "1.5e-3"; a zero denominator throws
+// like the constructor, and values out of the range of Rational<T> give result_out_of_range
+template <std::signed_integral T>
+constexpr std::from_chars_result from_chars(const char*, const char*, Rational<T>&);
+
+enum class BinaryEncoding {
+    plain,
+    // numer and denom relative to the previous value, for slowly changing series
+    delta,
+};
+
+// Zigzag LEB128 varints of numer and denom
+template <std::signed_integral T>
+struct BinaryWriter {
+    constexpr static std::size_t max_size = 2 * ((std::numeric_limits<std::make_unsigned_t<T>>::digits + 6) / 7);
+
+    explicit constexpr BinaryWriter(BinaryEncoding encoding = BinaryEncoding::plain) noexcept : encoding_{encoding} {}
+
+    // Writes at most max_size bytes
+    template <std::output_iterator<std::byte> Iterator>
+    constexpr Iterator write(Iterator, const Rational<T>&) noexcept;
+
+private:
+    BinaryEncoding encoding_;
+    T numer_ = 0;
+    std::make_unsigned_t<T> denom_ = 1;
+};
+
+// Decodes in place from a byte range such as a memory-mapped file; malformed input throws std::invalid_argument
+template <std::signed_integral T>
+struct BinaryReader {
+    explicit constexpr BinaryReader(std::span<const std::byte> data, BinaryEncoding encoding = BinaryEncoding::plain) noexcept
+        : data_{data}, encoding_{encoding}
+    {
+    }
+
+    constexpr bool empty() const noexcept { return position_ == data_.size(); }
+    constexpr std::size_t position() const noexcept { return position_; }
+
+    constexpr std::optional<Rational<T>> next();
+
+private:
+    std::span<const std::byte> data_;
+    std::size_t position_ = 0;
+    BinaryEncoding encoding_;
+    T numer_ = 0;
+    std::make_unsigned_t<T> denom_ = 1;
+};
+}  // namespace rational
+
+// Compiled only where the standard library provides <format> (__cpp_lib_format); GCC 12 does not
+#if defined(__cpp_lib_format)
+template <std::signed_integral T>
+struct std::formatter<Rational<T>> : std::formatter<std::string_view> {
+    template <class FormatContext>
+    auto format(const Rational<T>&, FormatContext&) const;
+};
+#endif
+
+#include "rational_io.ipp"
@@ -0,0 +1,260 @@
+#pragma once
+
+#include "rational_gcd.hpp"
+#include "rational_io.hpp"
+#include "rational_wide.hpp"
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <system_error>
+
+namespace rational::detail
+{
+template <unsigned_word U>
+constexpr void append_digit(U& value, char digit, bool& overflow) noexcept
+{
+    constexpr U limit = (std::numeric_limits<U>::max() - 9) / 10;
+    if (value > limit) {
+        overflow = true;
+    } else {
+        value = static_cast<U>(value * 10 + static_cast<U>(digit - '0'));
+    }
+}
+template <unsigned_word U>
+constexpr const char* parse_digits(const char* first, const char* last, U& value, bool& overflow) noexcept
+{
+    for (; first != last && '0' <= *first && *first <= '9'; ++first) {
+        append_digit(value, *first, overflow);
+    }
+    return first;
+}
+
+template <std::unsigned_integral U>
+constexpr U zigzag_encode(U value) noexcept
+{
+    return static_cast<U>(static_cast<U>(value << 1) ^ (value >> (std::numeric_limits<U>::digits - 1) != 0 ? std::numeric_limits<U>::max() : U{0}));
+}
+template <std::unsigned_integral U>
+constexpr U zigzag_decode(U value) noexcept
+{
+    return static_cast<U>((value >> 1) ^ static_cast<U>(U{0} - (value & 1)));
+}
+
+template <std::unsigned_integral U, std::output_iterator<std::byte> Iterator>
+constexpr Iterator write_varint(Iterator out, U value) noexcept
+{
+    for (; value >= 0x80; value = static_cast<U>(value >> 7)) {
+        *out++ = static_cast<std::byte>(value | 0x80);
+    }
+    *out++ = static_cast<std::byte>(value);
+    return out;
+}
+template <std::unsigned_integral U>
+constexpr U read_varint(std::span<const std::byte> data, std::size_t& position)
+{
+    constexpr int digits = std::numeric_limits<U>::digits;
+
+    U value = 0;
+    for (int shift = 0;; shift += 7) {
+        if (position == data.size()) {
+            throw std::invalid_argument{"truncated Rational stream"};
+        }
+        const auto byte = std::to_integer<unsigned>(data[position++]);
+        const auto bits = static_cast<U>(byte & 0x7f);
+        if (shift >= digits || (digits - shift < 7 && bits >> (digits - shift) != 0)) {
+            throw std::invalid_argument{"varint in Rational stream overflows"};
+        }
+        value = static_cast<U>(value | static_cast<U>(bits << shift));
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+}
+}  // namespace rational::detail
+
+namespace rational
+{
+template <std::signed_integral T>
+std::to_chars_result to_chars(char* first, char* last, const Rational<T>& value) noexcept
+{
+    // to_chars of character types prints numbers too, but promoting keeps it obvious
+    using Numer = std::conditional_t<(sizeof(T) < sizeof(int)), int, T>;
+    using Denom = std::make_unsigned_t<Numer>;
+
+    const auto result = std::to_chars(first, last, static_cast<Numer>(value.numer()));
+    if (result.ec != std::errc{} || value.denom() == 1) {
+        return result;
+    }
+    if (result.ptr == last) {
+        return {last, std::errc::value_too_large};
+    }
+    *result.ptr = '/';
+    return std::to_chars(result.ptr + 1, last, static_cast<Denom>(value.denom()));
+}
+
+template <std::signed_integral T>
+constexpr std::from_chars_result from_chars(const char* first, const char* last, Rational<T>& value)
+{
+    using Unsigned = std::make_unsigned_t<T>;
+    using Word = detail::wide_unsigned_t<T>;
+    constexpr auto max = static_cast<Word>(std::numeric_limits<T>::max());
+    constexpr std::int64_t exponent_limit = 1 << 16;
+
+    auto it = first;
+    const bool negative = it != last && *it == '-';
+    if (negative) {
+        ++it;
+    }
+
+    Word numer = 0;
+    bool overflow = false;
+    const auto integer_end = detail::parse_digits(it, last, numer, overflow);
+    bool has_digits = integer_end != it;
+    it = integer_end;
+
+    if (has_digits && it != last && *it == '/') {
+        auto denom_it = it + 1;
+        const bool denom_negative = denom_it != last && *denom_it == '-';
+        if (denom_negative) {
+            ++denom_it;
+        }
+        Word denom = 0;
+        if (const auto denom_end = detail::parse_digits(denom_it, last, denom, overflow); denom_end != denom_it) {
+            if (overflow) {
+                return {denom_end, std::errc::result_out_of_range};
+            }
+            // reduced before the range check, as the decimal form is; a zero denom is left to Rational to reject
+            if (denom != 0) {
+                const auto gcd = detail::binary_gcd(numer, denom);
+                numer = static_cast<Word>(numer / gcd);
+                denom = static_cast<Word>(denom / gcd);
+            }
+            // the sign moves to the numerator, so only a negative result may reach -min
+            const bool result_negative = negative != denom_negative;
+            if (numer > max + (result_negative ? 1 : 0) || denom > std::numeric_limits<Unsigned>::max()) {
+                return {denom_end, std::errc::result_out_of_range};
+            }
+            value = Rational<T>{detail::with_sign<T>(result_negative, static_cast<Unsigned>(numer)), static_cast<Unsigned>(denom)};
+            return {denom_end, std::errc{}};
+        }
+    }
+
+    // value = numer / 10^scale; trailing zeros of the fraction are dropped so they cannot overflow
+    std::int64_t scale = 0;
+    if (it != last && *it == '.') {
+        auto digit = it + 1;
+        std::int64_t zeros = 0;
+        for (; digit != last && '0' <= *digit && *digit <= '9'; ++digit) {
+            if (*digit == '0') {
+                ++zeros;
+                continue;
+            }
+            for (; zeros > 0; --zeros, ++scale) {
+                detail::append_digit(numer, '0', overflow);
+            }
+            detail::append_digit(numer, *digit, overflow);
+            ++scale;
+        }
+        if (has_digits || digit != it + 1) {
+            has_digits = true;
+            it = digit;
+        }
+    }
+    if (!has_digits) {
+        return {first, std::errc::invalid_argument};
+    }
+    if (it != last && (*it == 'e' || *it == 'E')) {
+        auto exponent_it = it + 1;
+        const bool exponent_negative = exponent_it != last && *exponent_it == '-';
+        if (exponent_it != last && (*exponent_it == '-' || *exponent_it == '+')) {
+            ++exponent_it;
+        }
+        std::uint64_t exponent = 0;
+        bool exponent_overflow = false;
+        if (const auto exponent_end = detail::parse_digits(exponent_it, last, exponent, exponent_overflow); exponent_end != exponent_it) {
+            const auto bounded = static_cast<std::int64_t>(exponent_overflow || exponent > exponent_limit ? exponent_limit : exponent);
+            scale += exponent_negative ? bounded : -bounded;
+            it = exponent_end;
+        }
+    }
+
+    if (overflow) {
+        return {it, std::errc::result_out_of_range};
+    }
+    if (numer == 0) {
+        value = Rational<T>{0};
+        return {it, std::errc{}};
+    }
+    Word denom = 1;
+    for (; scale > 0 && numer % 10 == 0; --scale) {
+        numer = static_cast<Word>(numer / 10);
+    }
+    for (; scale > 0; --scale) {
+        if (!detail::checked_multiply(denom, Word{10}, denom)) {
+            return {it, std::errc::result_out_of_range};
+        }
+    }
+    for (; scale < 0; ++scale) {
+        if (!detail::checked_multiply(numer, Word{10}, numer)) {
+            return {it, std::errc::result_out_of_range};
+        }
+    }
+    const auto gcd = detail::binary_gcd(numer, denom);
+    numer = static_cast<Word>(numer / gcd);
+    denom = static_cast<Word>(denom / gcd);
+    if (numer > max + (negative ? 1 : 0) || denom > std::numeric_limits<Unsigned>::max()) {
+        return {it, std::errc::result_out_of_range};
+    }
+    value = Rational<T>{detail::with_sign<T>(negative, static_cast<Unsigned>(numer)), static_cast<Unsigned>(denom)};
+    return {it, std::errc{}};
+}
+
+template <std::signed_integral T>
+template <std::output_iterator<std::byte> Iterator>
+constexpr Iterator BinaryWriter<T>::write(Iterator out, const Rational<T>& value) noexcept
+{
+    using Unsigned = std::make_unsigned_t<T>;
+
+    if (encoding_ == BinaryEncoding::delta) {
+        const auto numer = static_cast<Unsigned>(static_cast<Unsigned>(value.numer()) - static_cast<Unsigned>(numer_));
+        const auto denom = static_cast<Unsigned>(value.denom() - denom_);
+        numer_ = value.numer();
+        denom_ = value.denom();
+        out = detail::write_varint(out, detail::zigzag_encode(numer));
+        return detail::write_varint(out, detail::zigzag_encode(denom));
+    }
+    out = detail::write_varint(out, detail::zigzag_encode(static_cast<Unsigned>(value.numer())));
+    return detail::write_varint(out, value.denom());
+}
+
+template <std::signed_integral T>
+constexpr std::optional<Rational<T>> BinaryReader<T>::next()
+{
+    using Unsigned = std::make_unsigned_t<T>;
+
+    if (empty()) {
+        return std::nullopt;
+    }
+    auto numer = detail::zigzag_decode(detail::read_varint<Unsigned>(data_, position_));
+    auto denom = detail::read_varint<Unsigned>(data_, position_);
+    if (encoding_ == BinaryEncoding::delta) {
+        numer = static_cast<Unsigned>(numer + static_cast<Unsigned>(numer_));
+        denom = static_cast<Unsigned>(detail::zigzag_decode(denom) + denom_);
+        numer_ = static_cast<T>(numer);
+        denom_ = denom;
+    }
+    return Rational<T>{static_cast<T>(numer), denom};
+}
+}  // namespace rational
+
+#if defined(__cpp_lib_format)
+template <std::signed_integral T>
+template <class FormatContext>
+auto std::formatter<Rational<T>>::format(const Rational<T>& value, FormatContext& context) const
+{
+    std::array<char, rational::max_chars<T>> buffer;
+    const auto result = rational::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    return std::formatter<std::string_view>::format(std::string_view{buffer.data(), static_cast<std::size_t>(result.ptr - buffer.data())}, context);
+}
+#endif
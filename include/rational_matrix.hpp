@@ -0,0 +1,64 @@
+#pragma once
+
+#include "rational.hpp"
+#include "rational_parallel.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+// Dense matrix of Rational<T>, stored row-major in one contiguous block.
+// determinant, rank, solve and inverse are exact: the rows are scaled to integers and reduced
+// by Bareiss' fraction-free elimination, in 128 bits while the entries allow it and in
+// BigInteger after that, with the row updates of each step spread over the pool
+template <std::signed_integral T>
+struct RationalMatrix {
+    using value_type = Rational<T>;
+    using NumeratorType = T;
+    using DenominatorType = std::make_unsigned_t<T>;
+
+    RationalMatrix() = default;
+    RationalMatrix(std::size_t rows, std::size_t cols, const Rational<T>& = Rational<T>{0});
+    RationalMatrix(std::initializer_list<std::initializer_list<Rational<T>>>);
+    static RationalMatrix identity(std::size_t);
+
+    std::size_t rows() const noexcept { return rows_; }
+    std::size_t cols() const noexcept { return cols_; }
+    bool empty() const noexcept { return values_.empty(); }
+
+    Rational<T>& operator()(std::size_t row, std::size_t col) noexcept { return values_[row * cols_ + col]; }
+    const Rational<T>& operator()(std::size_t row, std::size_t col) const noexcept { return values_[row * cols_ + col]; }
+    std::span<Rational<T>> row(std::size_t row) noexcept { return {values_.data() + row * cols_, cols_}; }
+    std::span<const Rational<T>> row(std::size_t row) const noexcept { return {values_.data() + row * cols_, cols_}; }
+    std::span<Rational<T>> values() noexcept { return values_; }
+    std::span<const Rational<T>> values() const noexcept { return values_; }
+
+    // rank takes any shape; determinant, solve and inverse throw std::invalid_argument unless the
+    // matrix is square, and solve and inverse std::range_error when it is singular.
+    // Results outside Rational<T> follow the overflow policy
+    Rational<T> determinant(rational::ThreadPool& = rational::default_thread_pool()) const;
+    std::size_t rank(rational::ThreadPool& = rational::default_thread_pool()) const;
+    std::vector<Rational<T>> solve(std::span<const Rational<T>>, rational::ThreadPool& = rational::default_thread_pool()) const;
+    RationalMatrix inverse(rational::ThreadPool& = rational::default_thread_pool()) const;
+
+private:
+    std::size_t rows_ = 0;
+    std::size_t cols_ = 0;
+    std::vector<Rational<T>> values_;
+
+    void check_square() const;
+};
+
+template <std::signed_integral T>
+bool operator==(const RationalMatrix<T>&, const RationalMatrix<T>&) noexcept;
+template <std::signed_integral T>
+bool operator!=(const RationalMatrix<T>&, const RationalMatrix<T>&) noexcept;
+
+// Each entry is one fused dot product, rounded once
+template <std::signed_integral T>
+RationalMatrix<T> operator*(const RationalMatrix<T>&, const RationalMatrix<T>&);
+
+#include "rational_matrix.ipp"
@@ -0,0 +1,453 @@
+#pragma once
+
+#include "big_integer.hpp"
+#include "big_rational.hpp"
+#include "rational_algorithm.hpp"
+#include "rational_gcd.hpp"
+#include "rational_matrix.hpp"
+#include "rational_parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rational::detail
+{
+// Entries of the integer matrix are int128_t until a step could overflow, then BigInteger
+using MatrixInteger = BigInteger<>;
+
+// Rows updated by one task of a Bareiss step, as a number of entries
+constexpr std::size_t matrix_grain = std::size_t{1} << 12;
+
+inline uint128_t entry_magnitude(int128_t value) noexcept
+{
+    return value < 0 ? uint128_t{0} - static_cast<uint128_t>(value) : static_cast<uint128_t>(value);
+}
+template <class V>
+V make_entry(bool negative, uint128_t magnitude)
+{
+    if constexpr (std::same_as<V, int128_t>) {
+        return negative ? -static_cast<int128_t>(magnitude) : static_cast<int128_t>(magnitude);
+    } else {
+        return V{negative, magnitude};
+    }
+}
+
+inline bool checked_multiply(int128_t lhs, int128_t rhs, int128_t& result) noexcept
+{
+    return !__builtin_mul_overflow(lhs, rhs, &result);
+}
+inline bool checked_subtract(int128_t lhs, int128_t rhs, int128_t& result) noexcept
+{
+    return !__builtin_sub_overflow(lhs, rhs, &result);
+}
+inline int128_t entry_gcd(int128_t lhs, int128_t rhs) noexcept
+{
+    return static_cast<int128_t>(binary_gcd(entry_magnitude(lhs), entry_magnitude(rhs)));
+}
+template <class Allocator>
+bool checked_multiply(const BigInteger<Allocator>& lhs, const BigInteger<Allocator>& rhs, BigInteger<Allocator>& result)
+{
+    result = lhs * rhs;
+    return true;
+}
+template <class Allocator>
+bool checked_subtract(const BigInteger<Allocator>& lhs, const BigInteger<Allocator>& rhs, BigInteger<Allocator>& result)
+{
+    result = lhs - rhs;
+    return true;
+}
+template <class Allocator>
+BigInteger<Allocator> entry_gcd(const BigInteger<Allocator>& lhs, const BigInteger<Allocator>& rhs)
+{
+    return BigInteger<Allocator>::gcd(lhs, rhs);
+}
+
+// The rows scaled by the LCM of their denominators, possibly augmented, and how far the
+// elimination of the first `columns` columns has come
+template <class V>
+struct Bareiss {
+    Bareiss(std::size_t rows, std::size_t cols, std::size_t columns) : rows{rows}, cols{cols}, columns{columns}, values(rows * cols, make_entry<V>(false, 0)) {}
+
+    std::size_t rows;
+    std::size_t cols;
+    std::size_t columns;
+    std::vector<V> values;
+    std::vector<V> scales;
+
+    std::size_t column = 0;
+    std::vector<std::size_t> pivots;
+    V previous = make_entry<V>(false, 1);
+    bool negative = false;
+    // Bound on the bit width of the rows not yet used as pivots, while V is int128_t
+    int width = 0;
+
+    V& at(std::size_t row, std::size_t col) noexcept { return values[row * cols + col]; }
+    const V& at(std::size_t row, std::size_t col) const noexcept { return values[row * cols + col]; }
+};
+
+// The matrix followed by rhs as one more column, or by the scaled identity; nullopt if V is too narrow
+template <class V, std::signed_integral T>
+std::optional<Bareiss<V>> make_bareiss(const RationalMatrix<T>& matrix, std::span<const Rational<T>> rhs, bool identity)
+{
+    const auto rows = matrix.rows(), columns = matrix.cols();
+    const bool column = !identity && !rhs.empty();
+    Bareiss<V> result{rows, columns + (identity ? rows : column ? 1 : 0), columns};
+    result.scales.reserve(rows);
+
+    const auto entry = [](const Rational<T>& value) { return make_entry<V>(value.numer() < 0, magnitude(value.numer())); };
+    for (std::size_t i = 0; i < rows; ++i) {
+        auto scale = make_entry<V>(false, 1);
+        const auto include = [&scale](const Rational<T>& value) {
+            const auto denom = make_entry<V>(false, value.denom());
+            return checked_multiply(V{scale / entry_gcd(scale, denom)}, denom, scale);
+        };
+        const auto scaled = [&scale, &entry](const Rational<T>& value, V& result) {
+            return checked_multiply(entry(value), V{scale / make_entry<V>(false, value.denom())}, result);
+        };
+
+        for (const auto& value : matrix.row(i)) {
+            if (!include(value)) {
+                return std::nullopt;
+            }
+        }
+        if (column && !include(rhs[i])) {
+            return std::nullopt;
+        }
+        for (std::size_t j = 0; j < columns; ++j) {
+            if (!scaled(matrix(i, j), result.at(i, j))) {
+                return std::nullopt;
+            }
+        }
+        if (identity) {
+            result.at(i, columns + i) = scale;
+        } else if (column && !scaled(rhs[i], result.at(i, columns))) {
+            return std::nullopt;
+        }
+        result.scales.push_back(std::move(scale));
+    }
+
+    if constexpr (std::same_as<V, int128_t>) {
+        for (const auto value : result.values) {
+            result.width = std::max(result.width, bit_width(entry_magnitude(value)));
+        }
+    }
+    return result;
+}
+
+inline Bareiss<MatrixInteger> promote(const Bareiss<int128_t>& wide)
+{
+    const auto convert = [](const std::vector<int128_t>& values) {
+        std::vector<MatrixInteger> result;
+        result.reserve(values.size());
+        for (const auto value : values) {
+            result.emplace_back(value < 0, entry_magnitude(value));
+        }
+        return result;
+    };
+    Bareiss<MatrixInteger> result{wide.rows, wide.cols, wide.columns};
+    result.values = convert(wide.values);
+    result.scales = convert(wide.scales);
+    result.column = wide.column;
+    result.pivots = wide.pivots;
+    result.previous = MatrixInteger{wide.previous < 0, entry_magnitude(wide.previous)};
+    result.negative = wide.negative;
+    return result;
+}
+
+// a[i][j] = (a[r][c] * a[i][j] - a[i][c] * a[r][j]) / previous pivot for the columns right of c;
+// returns the bit width of the new row while V is int128_t
+template <class V>
+int bareiss_row(Bareiss<V>& m, std::size_t row, std::size_t col, std::size_t target)
+{
+    const auto one = make_entry<V>(false, 1), zero = make_entry<V>(false, 0);
+    const V* pivot_row = &m.values[row * m.cols];
+    V* values = &m.values[target * m.cols];
+    const V& pivot = pivot_row[col];
+    const V lead = std::move(values[col]);
+    values[col] = zero;
+
+    int width = 0;
+    for (std::size_t j = col + 1; j < m.cols; ++j) {
+        auto& value = values[j];
+        value *= pivot;
+        if (lead != zero) {
+            value -= lead * pivot_row[j];
+        }
+        if (m.previous != one) {
+            value /= m.previous;
+        }
+        if constexpr (std::same_as<V, int128_t>) {
+            width = std::max(width, bit_width(entry_magnitude(value)));
+        }
+    }
+    return width;
+}
+
+// Eliminates the remaining columns; false when an int128_t step could overflow, leaving m
+// consistent so that it can be promoted and continued
+template <class V>
+bool eliminate(Bareiss<V>& m, ThreadPool& pool)
+{
+    const auto zero = make_entry<V>(false, 0);
+    for (; m.column < m.columns && m.pivots.size() < m.rows; ++m.column) {
+        if constexpr (std::same_as<V, int128_t>) {
+            // |p * a - l * r| < 2^(2 * width + 1)
+            if (2 * m.width + 1 > 127) {
+                return false;
+            }
+        }
+
+        const auto row = m.pivots.size(), col = m.column;
+        auto found = row;
+        while (found < m.rows && m.at(found, col) == zero) {
+            ++found;
+        }
+        if (found == m.rows) {
+            continue;
+        }
+        if (found != row) {
+            std::swap_ranges(m.values.begin() + static_cast<std::ptrdiff_t>(found * m.cols), m.values.begin() + static_cast<std::ptrdiff_t>((found + 1) * m.cols),
+                m.values.begin() + static_cast<std::ptrdiff_t>(row * m.cols));
+            m.negative = !m.negative;
+        }
+
+        const auto below = m.rows - row - 1;
+        const auto tasks = std::min({below, pool.size() * 4, below * (m.cols - col) / matrix_grain + 1});
+        std::vector<int> widths(tasks, 0);
+        pool.run(tasks, [&](std::size_t task) {
+            const auto begin = row + 1 + below * task / tasks, end = row + 1 + below * (task + 1) / tasks;
+            for (auto i = begin; i < end; ++i) {
+                widths[task] = std::max(widths[task], bareiss_row(m, row, col, i));
+            }
+        });
+        m.width = widths.empty() ? 0 : *std::max_element(widths.begin(), widths.end());
+        m.previous = m.at(row, col);
+        m.pivots.push_back(col);
+    }
+    return true;
+}
+
+// The column of rhs after a full-rank elimination, solved as D * x with D the last pivot:
+// D * x is integral, so every division is exact
+template <class V>
+bool back_substitute(const Bareiss<V>& m, std::size_t rhs, std::vector<V>& solution)
+{
+    const auto n = m.rows;
+    const V& det = m.at(n - 1, n - 1);
+    for (auto i = n; i-- > 0;) {
+        V sum, term;
+        if (!checked_multiply(det, m.at(i, rhs), sum)) {
+            return false;
+        }
+        for (auto j = i + 1; j < n; ++j) {
+            if (!checked_multiply(m.at(i, j), solution[j], term) || !checked_subtract(sum, term, sum)) {
+                return false;
+            }
+        }
+        solution[i] = sum / m.at(i, i);
+    }
+    return true;
+}
+
+template <std::signed_integral T>
+Rational<T> to_rational(int128_t numer, int128_t denom)
+{
+    using Unsigned = std::make_unsigned_t<T>;
+    const bool negative = (numer < 0) != (denom < 0) && numer != 0;
+    auto numer_magnitude = entry_magnitude(numer), denom_magnitude = entry_magnitude(denom);
+    const auto gcd = binary_gcd(numer_magnitude, denom_magnitude);
+    numer_magnitude /= gcd;
+    denom_magnitude /= gcd;
+
+    const auto numer_limit = static_cast<uint128_t>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+    if (numer_magnitude <= numer_limit && denom_magnitude <= std::numeric_limits<Unsigned>::max()) {
+        return Rational<T>{with_sign<T>(negative, static_cast<Unsigned>(numer_magnitude)), static_cast<Unsigned>(denom_magnitude)};
+    }
+    return static_cast<Rational<T>>(BigRational{MatrixInteger{negative, numer_magnitude}, MatrixInteger{false, denom_magnitude}});
+}
+template <std::signed_integral T>
+Rational<T> to_rational(const MatrixInteger& numer, const MatrixInteger& denom)
+{
+    return static_cast<Rational<T>>(BigRational{numer, denom});
+}
+
+// finish(m) on the eliminated matrix, in int128_t when it stays exact and in BigInteger otherwise.
+// finish returns nullopt when int128_t is too narrow for what it computes after the elimination
+template <std::signed_integral T, class Finish>
+auto with_bareiss(const RationalMatrix<T>& matrix, std::span<const Rational<T>> rhs, bool identity, ThreadPool& pool, Finish finish)
+{
+    auto wide = make_bareiss<int128_t>(matrix, rhs, identity);
+    auto big = [&] {
+        if (!wide) {
+            return *make_bareiss<MatrixInteger>(matrix, rhs, identity);
+        }
+        return promote(*wide);
+    };
+
+    if (wide && eliminate(*wide, pool)) {
+        if (auto result = finish(*wide)) {
+            return std::move(*result);
+        }
+    }
+    auto promoted = big();
+    eliminate(promoted, pool);
+    return std::move(*finish(promoted));
+}
+}  // namespace rational::detail
+
+template <std::signed_integral T>
+RationalMatrix<T>::RationalMatrix(std::size_t rows, std::size_t cols, const Rational<T>& value) : rows_{rows}, cols_{cols}, values_(rows * cols, value)
+{
+}
+template <std::signed_integral T>
+RationalMatrix<T>::RationalMatrix(std::initializer_list<std::initializer_list<Rational<T>>> rows)
+    : rows_{rows.size()}, cols_{rows.size() == 0 ? 0 : rows.begin()->size()}
+{
+    values_.reserve(rows_ * cols_);
+    for (const auto& row : rows) {
+        if (row.size() != cols_) {
+            throw std::invalid_argument{"rows of RationalMatrix differ in length"};
+        }
+        values_.insert(values_.end(), row.begin(), row.end());
+    }
+}
+template <std::signed_integral T>
+auto RationalMatrix<T>::identity(std::size_t size) -> RationalMatrix
+{
+    RationalMatrix result{size, size};
+    for (std::size_t i = 0; i < size; ++i) {
+        result(i, i) = Rational<T>{1};
+    }
+    return result;
+}
+
+template <std::signed_integral T>
+void RationalMatrix<T>::check_square() const
+{
+    if (rows_ != cols_) {
+        throw std::invalid_argument{"RationalMatrix is not square"};
+    }
+}
+
+template <std::signed_integral T>
+Rational<T> RationalMatrix<T>::determinant(rational::ThreadPool& pool) const
+{
+    using rational::detail::make_entry;
+
+    check_square();
+    if (rows_ == 0) {
+        return Rational<T>{1};
+    }
+    return rational::detail::with_bareiss(*this, {}, false, pool, [this]<class V>(const rational::detail::Bareiss<V>& m) -> std::optional<Rational<T>> {
+        if (m.pivots.size() < rows_) {
+            return Rational<T>{0};
+        }
+        auto numer = m.at(rows_ - 1, rows_ - 1), denom = make_entry<V>(false, 1);
+        if (m.negative && !rational::detail::checked_subtract(make_entry<V>(false, 0), V{numer}, numer)) {
+            return std::nullopt;
+        }
+        for (const auto& scale : m.scales) {
+            if (!rational::detail::checked_multiply(V{denom}, scale, denom)) {
+                return std::nullopt;
+            }
+        }
+        return rational::detail::to_rational<T>(numer, denom);
+    });
+}
+template <std::signed_integral T>
+std::size_t RationalMatrix<T>::rank(rational::ThreadPool& pool) const
+{
+    return rational::detail::with_bareiss(*this, {}, false, pool, []<class V>(const rational::detail::Bareiss<V>& m) -> std::optional<std::size_t> {
+        return m.pivots.size();
+    });
+}
+template <std::signed_integral T>
+std::vector<Rational<T>> RationalMatrix<T>::solve(std::span<const Rational<T>> rhs, rational::ThreadPool& pool) const
+{
+    check_square();
+    if (rhs.size() != rows_) {
+        throw std::invalid_argument{"size of the right-hand side differs from RationalMatrix"};
+    }
+    if (rows_ == 0) {
+        return {};
+    }
+    return rational::detail::with_bareiss(*this, rhs, false, pool, [this]<class V>(const rational::detail::Bareiss<V>& m) -> std::optional<std::vector<Rational<T>>> {
+        if (m.pivots.size() < rows_) {
+            throw std::range_error{"RationalMatrix is singular"};
+        }
+        std::vector<V> solution(rows_);
+        if (!rational::detail::back_substitute(m, rows_, solution)) {
+            return std::nullopt;
+        }
+        std::vector<Rational<T>> result;
+        result.reserve(rows_);
+        for (const auto& value : solution) {
+            result.push_back(rational::detail::to_rational<T>(value, m.at(rows_ - 1, rows_ - 1)));
+        }
+        return result;
+    });
+}
+template <std::signed_integral T>
+auto RationalMatrix<T>::inverse(rational::ThreadPool& pool) const -> RationalMatrix
+{
+    check_square();
+    return rational::detail::with_bareiss(*this, {}, true, pool, [this, &pool]<class V>(const rational::detail::Bareiss<V>& m) -> std::optional<RationalMatrix> {
+        if (m.pivots.size() < rows_) {
+            throw std::range_error{"RationalMatrix is singular"};
+        }
+        RationalMatrix result{rows_, rows_};
+        std::atomic<bool> overflow = false;
+        pool.run(rows_, [&](std::size_t col) {
+            std::vector<V> solution(rows_);
+            if (overflow.load(std::memory_order_relaxed) || !rational::detail::back_substitute(m, rows_ + col, solution)) {
+                overflow.store(true, std::memory_order_relaxed);
+                return;
+            }
+            for (std::size_t i = 0; i < rows_; ++i) {
+                result(i, col) = rational::detail::to_rational<T>(solution[i], m.at(rows_ - 1, rows_ - 1));
+            }
+        });
+        if (overflow) {
+            return std::nullopt;
+        }
+        return result;
+    });
+}
+
+template <std::signed_integral T>
+bool operator==(const RationalMatrix<T>& lhs, const RationalMatrix<T>& rhs) noexcept
+{
+    return lhs.rows() == rhs.rows() && lhs.cols() == rhs.cols() && std::ranges::equal(lhs.values(), rhs.values());
+}
+template <std::signed_integral T>
+bool operator!=(const RationalMatrix<T>& lhs, const RationalMatrix<T>& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+template <std::signed_integral T>
+RationalMatrix<T> operator*(const RationalMatrix<T>& lhs, const RationalMatrix<T>& rhs)
+{
+    if (lhs.cols() != rhs.rows()) {
+        throw std::invalid_argument{"sizes of RationalMatrix do not match"};
+    }
+    RationalMatrix<T> result{lhs.rows(), rhs.cols()};
+    for (std::size_t i = 0; i < lhs.rows(); ++i) {
+        for (std::size_t j = 0; j < rhs.cols(); ++j) {
+            rational::detail::Accumulator<T> accumulator;
+            for (std::size_t k = 0; k < lhs.cols(); ++k) {
+                accumulator.add_product(lhs(i, k), rhs(k, j));
+            }
+            result(i, j) = accumulator.result();
+        }
+    }
+    return result;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "rational.hpp"
+#include "rational_algorithm.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace rational
+{
+// Worker threads with one deque each: a worker pops its own tasks LIFO and steals the
+// others' FIFO, and a thread waiting in run() executes tasks as well
+struct ThreadPool {
+    explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency());
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool();
+
+    // Concurrency of run(), counting the calling thread
+    std::size_t size() const noexcept { return threads_.size() + 1; }
+
+    // Calls task(i) for every i in [0, count) and waits; the exception of the lowest i is rethrown
+    template <class F>
+    void run(std::size_t count, F&& task);
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> threads_;
+    std::atomic<std::size_t> queued_ = 0;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+
+    void work(std::size_t index);
+    bool try_run(std::size_t index);
+};
+
+inline ThreadPool& default_thread_pool();
+
+template <class Range>
+concept contiguous_rational_range = rational_range<Range> && std::ranges::contiguous_range<Range> && std::ranges::sized_range<Range>;
+
+// Inputs are cut into chunks of a fixed size, independent of the pool, and the per-chunk
+// results are combined in index order, so the result does not depend on the scheduling
+constexpr std::size_t parallel_grain = std::size_t{1} << 14;
+
+template <contiguous_rational_range Range>
+Rational<range_numerator_t<Range>> parallel_sum(Range&&, ThreadPool& = default_thread_pool());
+
+template <contiguous_rational_range Lhs, contiguous_rational_range Rhs>
+requires std::common_with<range_numerator_t<Lhs>, range_numerator_t<Rhs>>
+auto parallel_dot(Lhs&&, Rhs&&, ThreadPool& = default_thread_pool())
+    -> Rational<std::common_type_t<range_numerator_t<Lhs>, range_numerator_t<Rhs>>>;
+
+// Sorts 16-byte (prefix, index) keys with a merge buffer of the same size, then gathers the values
+// into a copy once the buffer is freed: at most 32 bytes per element on top of the input
+template <contiguous_rational_range Range>
+void parallel_sort(Range&&, ThreadPool& = default_thread_pool());
+}  // namespace rational
+
+#include "rational_parallel.ipp"
@@ -0,0 +1,343 @@
+#pragma once
+
+#include "rational_algorithm.hpp"
+#include "rational_gcd.hpp"
+#include "rational_parallel.hpp"
+#include "rational_wide.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <exception>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+
+namespace rational
+{
+inline ThreadPool::ThreadPool(std::size_t threads)
+{
+    for (std::size_t i = 1; i < threads; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    for (std::size_t i = 0; i < queues_.size(); ++i) {
+        threads_.emplace_back([this, i] { work(i); });
+    }
+}
+inline ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock{mutex_};
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+template <class F>
+void ThreadPool::run(std::size_t count, F&& task)
+{
+    if (threads_.empty() || count <= 1) {
+        for (std::size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    // Shared with the tasks, since the last one still notifies after run() may have seen zero
+    struct Batch {
+        std::atomic<std::size_t> remaining;
+        std::mutex mutex;
+        std::size_t error_index;
+        std::exception_ptr error;
+    };
+    const auto batch = std::make_shared<Batch>();
+    batch->remaining = count;
+    batch->error_index = count;
+
+    {
+        std::lock_guard lock{mutex_};
+        queued_ += count;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        auto& queue = *queues_[i % queues_.size()];
+        std::lock_guard lock{queue.mutex};
+        queue.tasks.emplace_back([batch, &task, i] {
+            try {
+                task(i);
+            } catch (...) {
+                std::lock_guard lock{batch->mutex};
+                if (i < batch->error_index) {
+                    batch->error_index = i;
+                    batch->error = std::current_exception();
+                }
+            }
+            if (batch->remaining.fetch_sub(1) == 1) {
+                batch->remaining.notify_all();
+            }
+        });
+    }
+    wake_.notify_all();
+
+    for (auto remaining = batch->remaining.load(); remaining != 0; remaining = batch->remaining.load()) {
+        if (!try_run(0)) {
+            batch->remaining.wait(remaining);
+        }
+    }
+    if (batch->error) {
+        std::rethrow_exception(batch->error);
+    }
+}
+
+inline void ThreadPool::work(std::size_t index)
+{
+    while (true) {
+        if (try_run(index)) {
+            continue;
+        }
+        std::unique_lock lock{mutex_};
+        wake_.wait(lock, [this] { return stop_ || queued_ != 0; });
+        if (stop_ && queued_ == 0) {
+            return;
+        }
+    }
+}
+inline bool ThreadPool::try_run(std::size_t index)
+{
+    for (std::size_t k = 0; k < queues_.size(); ++k) {
+        auto& queue = *queues_[(index + k) % queues_.size()];
+        std::function<void()> task;
+        {
+            std::lock_guard lock{queue.mutex};
+            if (queue.tasks.empty()) {
+                continue;
+            }
+            if (k == 0) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            } else {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+        }
+        --queued_;
+        task();
+        return true;
+    }
+    return false;
+}
+
+inline ThreadPool& default_thread_pool()
+{
+    static ThreadPool pool;
+    return pool;
+}
+}  // namespace rational
+
+namespace rational::detail
+{
+struct SortKey {
+    std::uint64_t prefix;
+    std::size_t index;
+};
+
+// An order-preserving key: numer/denom in fixed point with as many fraction bits as T, truncated,
+// and for 64-bit T packed like a float into the bit width and the leading 55 bits
+template <std::signed_integral T>
+constexpr std::uint64_t sort_prefix(const Rational<T>& value) noexcept
+{
+    using Word = wide_unsigned_t<T>;
+    constexpr int fraction = std::numeric_limits<std::make_unsigned_t<T>>::digits;
+    constexpr auto zero = std::uint64_t{1} << 63;
+
+    const auto scaled = quotient(static_cast<Word>(Word{magnitude(value.numer())} << fraction), value.denom());
+    std::uint64_t key;
+    if constexpr (sizeof(Word) <= sizeof(std::uint64_t)) {
+        key = scaled;
+    } else {
+        const auto width = bit_width(scaled);
+        key = static_cast<std::uint64_t>(width) << 55
+            | (width > 55 ? static_cast<std::uint64_t>(scaled >> (width - 55)) : static_cast<std::uint64_t>(scaled) << (55 - width));
+    }
+    return value.numer() < 0 ? zero - key : zero + key;
+}
+
+// Stable LSD radix sort on the prefixes, skipping the bytes all keys share
+inline void radix_sort(std::span<SortKey> keys, std::span<SortKey> buffer) noexcept
+{
+    std::array<std::array<std::size_t, 256>, sizeof(std::uint64_t)> counts{};
+    for (const auto& key : keys) {
+        for (std::size_t byte = 0; byte < counts.size(); ++byte) {
+            ++counts[byte][key.prefix >> (8 * byte) & 0xff];
+        }
+    }
+
+    auto source = keys.data(), target = buffer.data();
+    for (std::size_t byte = 0; byte < counts.size(); ++byte) {
+        auto& offsets = counts[byte];
+        if (std::find(offsets.begin(), offsets.end(), keys.size()) != offsets.end()) {
+            continue;
+        }
+        std::size_t offset = 0;
+        for (auto& count : offsets) {
+            offset += std::exchange(count, offset);
+        }
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            target[offsets[source[i].prefix >> (8 * byte) & 0xff]++] = source[i];
+        }
+        std::swap(source, target);
+    }
+    if (source != keys.data()) {
+        std::copy(source, source + keys.size(), keys.data());
+    }
+}
+
+constexpr std::size_t chunk_count(std::size_t size) noexcept
+{
+    return (size + parallel_grain - 1) / parallel_grain;
+}
+template <class T>
+constexpr std::span<T> chunk(std::span<T> values, std::size_t index) noexcept
+{
+    const auto offset = index * parallel_grain;
+    return values.subspan(offset, std::min(parallel_grain, values.size() - offset));
+}
+
+// Number of elements of lhs among the first rank elements of the merge of lhs and rhs
+template <class T, class Less>
+std::size_t merge_path(std::span<const T> lhs, std::span<const T> rhs, std::size_t rank, Less less)
+{
+    auto low = rank > rhs.size() ? rank - rhs.size() : 0, high = std::min(rank, lhs.size());
+    while (low < high) {
+        const auto middle = low + (high - low) / 2;
+        if (rank - middle > 0 && !less(rhs[rank - middle - 1], lhs[middle])) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+// Writes the outputs [begin, end) of the merge of lhs and rhs to output + begin
+template <class T, class Less>
+void merge_slice(std::span<const T> lhs, std::span<const T> rhs, std::size_t begin, std::size_t end, T* output, Less less)
+{
+    const auto lhs_begin = merge_path(lhs, rhs, begin, less), lhs_end = merge_path(lhs, rhs, end, less);
+    std::merge(lhs.begin() + lhs_begin, lhs.begin() + lhs_end, rhs.begin() + (begin - lhs_begin), rhs.begin() + (end - lhs_end), output + begin, less);
+}
+}  // namespace rational::detail
+
+namespace rational
+{
+template <contiguous_rational_range Range>
+Rational<range_numerator_t<Range>> parallel_sum(Range&& range, ThreadPool& pool)
+{
+    using T = range_numerator_t<Range>;
+
+    const std::span<const Rational<T>> values{std::ranges::data(range), std::ranges::size(range)};
+    std::vector<detail::Accumulator<T>> partials(detail::chunk_count(values.size()));
+    pool.run(partials.size(), [&](std::size_t index) {
+        for (const auto& value : detail::chunk(values, index)) {
+            partials[index].add(value);
+        }
+    });
+
+    detail::Accumulator<T> accumulator;
+    for (const auto& partial : partials) {
+        accumulator.merge(partial);
+    }
+    return accumulator.result();
+}
+
+template <contiguous_rational_range Lhs, contiguous_rational_range Rhs>
+requires std::common_with<range_numerator_t<Lhs>, range_numerator_t<Rhs>>
+auto parallel_dot(Lhs&& lhs, Rhs&& rhs, ThreadPool& pool)
+    -> Rational<std::common_type_t<range_numerator_t<Lhs>, range_numerator_t<Rhs>>>
+{
+    using T = std::common_type_t<range_numerator_t<Lhs>, range_numerator_t<Rhs>>;
+
+    const auto size = std::min<std::size_t>(std::ranges::size(lhs), std::ranges::size(rhs));
+    const std::span<const Rational<range_numerator_t<Lhs>>> lhs_values{std::ranges::data(lhs), size};
+    const std::span<const Rational<range_numerator_t<Rhs>>> rhs_values{std::ranges::data(rhs), size};
+    std::vector<detail::Accumulator<T>> partials(detail::chunk_count(size));
+    pool.run(partials.size(), [&](std::size_t index) {
+        const auto lhs_chunk = detail::chunk(lhs_values, index);
+        const auto rhs_chunk = detail::chunk(rhs_values, index);
+        for (std::size_t i = 0; i < lhs_chunk.size(); ++i) {
+            partials[index].add_product(static_cast<Rational<T>>(lhs_chunk[i]), static_cast<Rational<T>>(rhs_chunk[i]));
+        }
+    });
+
+    detail::Accumulator<T> accumulator;
+    for (const auto& partial : partials) {
+        accumulator.merge(partial);
+    }
+    return accumulator.result();
+}
+
+template <contiguous_rational_range Range>
+void parallel_sort(Range&& range, ThreadPool& pool)
+{
+    using T = range_numerator_t<Range>;
+    using Key = detail::SortKey;
+
+    const std::span<Rational<T>> values{std::ranges::data(range), std::ranges::size(range)};
+    const auto size = values.size();
+    if (size < 2) {
+        return;
+    }
+    // values stay in place until the final permutation, so ties are resolved on them directly
+    std::vector<Key> keys(size), buffer(size);
+    const auto less = [&values](const Key& lhs, const Key& rhs) {
+        return lhs.prefix != rhs.prefix ? lhs.prefix < rhs.prefix : values[lhs.index] < values[rhs.index];
+    };
+
+    pool.run(detail::chunk_count(size), [&](std::size_t index) {
+        const auto chunk = detail::chunk(std::span{keys}, index);
+        for (std::size_t i = 0, offset = index * parallel_grain; i < chunk.size(); ++i) {
+            chunk[i] = {detail::sort_prefix(values[offset + i]), offset + i};
+        }
+    });
+
+    // A few sorted runs per thread, then rounds of pairwise merges split along the merge path
+    const auto runs = pool.size() == 1 ? 1 : std::min(detail::chunk_count(size), std::bit_ceil(pool.size()) * 2);
+    const auto run_size = (size + runs - 1) / runs;
+    pool.run(runs, [&](std::size_t index) {
+        const auto first = std::min(index * run_size, size), last = std::min(first + run_size, size);
+        detail::radix_sort(std::span{keys}.subspan(first, last - first), std::span{buffer}.subspan(first, last - first));
+        // Equal prefixes are ordered exactly
+        for (auto it = keys.begin() + first, end = keys.begin() + last; it != end;) {
+            const auto next = std::find_if(it, end, [prefix = it->prefix](const Key& key) { return key.prefix != prefix; });
+            if (next - it > 1) {
+                std::sort(it, next, less);
+            }
+            it = next;
+        }
+    });
+    const auto piece = std::max(parallel_grain, (size + 4 * pool.size() - 1) / (4 * pool.size()));
+    for (auto width = run_size; width < size; width *= 2) {
+        const auto pieces = (2 * width + piece - 1) / piece;
+        pool.run((size + 2 * width - 1) / (2 * width) * pieces, [&](std::size_t index) {
+            const auto first = index / pieces * 2 * width;
+            const auto middle = std::min(first + width, size), last = std::min(first + 2 * width, size);
+            const auto begin = std::min(index % pieces * piece, last - first), end = std::min(begin + piece, last - first);
+            detail::merge_slice(std::span<const Key>{keys}.subspan(first, middle - first), std::span<const Key>{keys}.subspan(middle, last - middle),
+                begin, end, buffer.data() + first, less);
+        });
+        keys.swap(buffer);
+    }
+
+    // The merge buffer is released first, so the keys and the copy never exceed the two key vectors
+    buffer = std::vector<Key>{};
+    std::vector<Rational<T>> sorted(size, Rational<T>{0});
+    pool.run(detail::chunk_count(size), [&](std::size_t index) {
+        for (std::size_t i = index * parallel_grain; i < std::min((index + 1) * parallel_grain, size); ++i) {
+            sorted[i] = values[keys[i].index];
+        }
+    });
+    std::copy(sorted.begin(), sorted.end(), values.begin());
+}
+}  // namespace rational
@@ -0,0 +1,209 @@
+#pragma once
+
+#include "rational_gcd.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define RATIONAL_X86_SIMD 1
+#include <immintrin.h>
+#else
+#define RATIONAL_X86_SIMD 0
+#endif
+
+namespace rational::detail
+{
+template <class T, std::size_t Alignment = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <class U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+    template <class U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept
+    {
+    }
+
+    T* allocate(std::size_t size)
+    {
+        return static_cast<T*>(::operator new(size * sizeof(T), std::align_val_t{Alignment}));
+    }
+    void deallocate(T* pointer, std::size_t) noexcept
+    {
+        ::operator delete(pointer, std::align_val_t{Alignment});
+    }
+
+    template <class U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept
+    {
+        return true;
+    }
+};
+
+enum class SimdLevel {
+    scalar,
+    avx2,
+    avx512,
+};
+
+inline SimdLevel simd_level() noexcept
+{
+#if RATIONAL_X86_SIMD
+    static const SimdLevel level = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512cd") && __builtin_cpu_supports("avx512dq")) {
+            return SimdLevel::avx512;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return SimdLevel::avx2;
+        }
+        return SimdLevel::scalar;
+    }();
+    return level;
+#else
+    return SimdLevel::scalar;
+#endif
+}
+
+// Divides each numer[i]/denom[i] by its GCD in place; denom[i] must be non-zero
+inline void reduce_wide_scalar(std::int64_t* numer, std::uint64_t* denom, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto gcd = binary_gcd(magnitude(numer[i]), denom[i]);
+        numer[i] = divide(numer[i], gcd);
+        denom[i] /= gcd;
+    }
+}
+
+#if RATIONAL_X86_SIMD
+#define RATIONAL_TARGET_AVX2 gnu::target("avx2")
+#define RATIONAL_TARGET_AVX512 gnu::target("avx2,avx512f,avx512cd,avx512dq")
+
+[[RATIONAL_TARGET_AVX2, gnu::always_inline]] inline __m256i countr_zero_avx2(__m256i value) noexcept
+{
+    // The exponent of the lowest set bit, converted per 32-bit half
+    const auto zero = _mm256_setzero_si256();
+    const auto lowest = _mm256_and_si256(value, _mm256_sub_epi64(zero, value));
+    const auto exponent = _mm256_and_si256(_mm256_srli_epi32(_mm256_castps_si256(_mm256_cvtepi32_ps(lowest)), 23), _mm256_set1_epi32(0xff));
+    const auto low = _mm256_and_si256(exponent, _mm256_set1_epi64x(0xffffffff));
+    const auto high = _mm256_srli_epi64(exponent, 32);
+    const auto low_zero = _mm256_cmpeq_epi64(low, zero);
+    const auto result = _mm256_blendv_epi8(_mm256_sub_epi64(low, _mm256_set1_epi64x(127)), _mm256_sub_epi64(high, _mm256_set1_epi64x(95)), low_zero);
+    return _mm256_blendv_epi8(result, _mm256_set1_epi64x(64), _mm256_and_si256(low_zero, _mm256_cmpeq_epi64(high, zero)));
+}
+[[RATIONAL_TARGET_AVX2, gnu::always_inline]] inline __m256i multiply_low_avx2(__m256i lhs, __m256i rhs) noexcept
+{
+    const auto cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(lhs, 32), rhs), _mm256_mul_epu32(lhs, _mm256_srli_epi64(rhs, 32)));
+    return _mm256_add_epi64(_mm256_mul_epu32(lhs, rhs), _mm256_slli_epi64(cross, 32));
+}
+[[RATIONAL_TARGET_AVX2, gnu::always_inline]] inline __m256i inverse_avx2(__m256i odd) noexcept
+{
+    const auto two = _mm256_set1_epi64x(2);
+    auto inverse = _mm256_xor_si256(multiply_low_avx2(odd, _mm256_set1_epi64x(3)), two);
+    for (int i = 0; i < 4; ++i) {
+        inverse = multiply_low_avx2(inverse, _mm256_sub_epi64(two, multiply_low_avx2(odd, inverse)));
+    }
+    return inverse;
+}
+[[RATIONAL_TARGET_AVX2]] inline void reduce_wide_avx2(std::int64_t* numer, std::uint64_t* denom, std::size_t count) noexcept
+{
+    const auto zero = _mm256_setzero_si256();
+    const auto sign = _mm256_set1_epi64x(std::int64_t{1} << 63);
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const auto signed_numer = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(numer + i));
+        const auto negative = _mm256_cmpgt_epi64(zero, signed_numer);
+        const auto magnitude = _mm256_sub_epi64(_mm256_xor_si256(signed_numer, negative), negative);
+        const auto divisor = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(denom + i));
+
+        const auto shift = countr_zero_avx2(_mm256_or_si256(magnitude, divisor));
+        auto u = _mm256_srlv_epi64(magnitude, countr_zero_avx2(magnitude));
+        auto v = _mm256_srlv_epi64(divisor, countr_zero_avx2(divisor));
+        auto active = _mm256_xor_si256(_mm256_cmpeq_epi64(u, zero), _mm256_set1_epi64x(-1));
+        while (!_mm256_testz_si256(active, active)) {
+            const auto greater = _mm256_cmpgt_epi64(_mm256_xor_si256(u, sign), _mm256_xor_si256(v, sign));
+            const auto smaller = _mm256_blendv_epi8(u, v, greater);
+            const auto difference = _mm256_sub_epi64(_mm256_blendv_epi8(v, u, greater), smaller);
+            u = _mm256_blendv_epi8(u, _mm256_srlv_epi64(difference, countr_zero_avx2(difference)), active);
+            v = _mm256_blendv_epi8(v, smaller, active);
+            active = _mm256_andnot_si256(_mm256_cmpeq_epi64(u, zero), active);
+        }
+
+        // gcd = v << shift with v odd, so dividing is a shift and a multiply by the inverse of v mod 2^64
+        const auto inverse = inverse_avx2(v);
+        const auto reduced = multiply_low_avx2(_mm256_srlv_epi64(magnitude, shift), inverse);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(numer + i), _mm256_sub_epi64(_mm256_xor_si256(reduced, negative), negative));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(denom + i), multiply_low_avx2(_mm256_srlv_epi64(divisor, shift), inverse));
+    }
+    reduce_wide_scalar(numer + i, denom + i, count - i);
+}
+
+// GCC 12 reports the _mm512_undefined_epi32() pass-through operands of the AVX-512 intrinsics as uninitialised
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+[[RATIONAL_TARGET_AVX512, gnu::always_inline]] inline __m512i countr_zero_avx512(__m512i value) noexcept
+{
+    const auto trailing = _mm512_andnot_si512(value, _mm512_sub_epi64(value, _mm512_set1_epi64(1)));
+    return _mm512_sub_epi64(_mm512_set1_epi64(64), _mm512_lzcnt_epi64(trailing));
+}
+[[RATIONAL_TARGET_AVX512, gnu::always_inline]] inline __m512i inverse_avx512(__m512i odd) noexcept
+{
+    const auto two = _mm512_set1_epi64(2);
+    auto inverse = _mm512_xor_si512(_mm512_mullo_epi64(odd, _mm512_set1_epi64(3)), two);
+    for (int i = 0; i < 4; ++i) {
+        inverse = _mm512_mullo_epi64(inverse, _mm512_sub_epi64(two, _mm512_mullo_epi64(odd, inverse)));
+    }
+    return inverse;
+}
+[[RATIONAL_TARGET_AVX512]] inline void reduce_wide_avx512(std::int64_t* numer, std::uint64_t* denom, std::size_t count) noexcept
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const auto signed_numer = _mm512_loadu_si512(numer + i);
+        const auto negative = _mm512_movepi64_mask(signed_numer);
+        const auto magnitude = _mm512_abs_epi64(signed_numer);
+        const auto divisor = _mm512_loadu_si512(denom + i);
+
+        const auto shift = countr_zero_avx512(_mm512_or_si512(magnitude, divisor));
+        auto u = _mm512_srlv_epi64(magnitude, countr_zero_avx512(magnitude));
+        auto v = _mm512_srlv_epi64(divisor, countr_zero_avx512(divisor));
+        auto active = _mm512_test_epi64_mask(u, u);
+        while (active != 0) {
+            const auto smaller = _mm512_min_epu64(u, v);
+            const auto difference = _mm512_sub_epi64(_mm512_max_epu64(u, v), smaller);
+            u = _mm512_mask_srlv_epi64(u, active, difference, countr_zero_avx512(difference));
+            v = _mm512_mask_mov_epi64(v, active, smaller);
+            active = _mm512_test_epi64_mask(u, u);
+        }
+
+        const auto inverse = inverse_avx512(v);
+        const auto reduced = _mm512_mullo_epi64(_mm512_srlv_epi64(magnitude, shift), inverse);
+        _mm512_storeu_si512(numer + i, _mm512_mask_sub_epi64(reduced, negative, _mm512_setzero_si512(), reduced));
+        _mm512_storeu_si512(denom + i, _mm512_mullo_epi64(_mm512_srlv_epi64(divisor, shift), inverse));
+    }
+    reduce_wide_scalar(numer + i, denom + i, count - i);
+}
+#pragma GCC diagnostic pop
+#endif
+
+inline void reduce_wide(SimdLevel level, std::int64_t* numer, std::uint64_t* denom, std::size_t count) noexcept
+{
+    switch (level) {
+#if RATIONAL_X86_SIMD
+    case SimdLevel::avx512:
+        return reduce_wide_avx512(numer, denom, count);
+    case SimdLevel::avx2:
+        return reduce_wide_avx2(numer, denom, count);
+#endif
+    default:
+        return reduce_wide_scalar(numer, denom, count);
+    }
+}
+}  // namespace rational::detail
@@ -0,0 +1,308 @@
+#pragma once
+
+#include "rational_gcd.hpp"
+
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace rational
+{
+struct WrapOnOverflow {
+};
+struct SaturateOnOverflow {
+};
+struct ThrowOnOverflow {
+};
+
+template <std::signed_integral T>
+struct OverflowPolicy {
+    using type = ThrowOnOverflow;
+};
+
+template <std::signed_integral T>
+using overflow_policy_t = typename OverflowPolicy<T>::type;
+template <std::signed_integral T>
+constexpr bool nothrow_overflow_v = !std::is_same_v<overflow_policy_t<T>, ThrowOnOverflow>;
+}  // namespace rational
+
+namespace rational::detail
+{
+template <std::size_t Size>
+struct wide_by_size;
+template <>
+struct wide_by_size<1> {
+    using signed_type = std::int16_t;
+    using unsigned_type = std::uint16_t;
+};
+template <>
+struct wide_by_size<2> {
+    using signed_type = std::int32_t;
+    using unsigned_type = std::uint32_t;
+};
+template <>
+struct wide_by_size<4> {
+    using signed_type = std::int64_t;
+    using unsigned_type = std::uint64_t;
+};
+template <>
+struct wide_by_size<8> {
+    using signed_type = int128_t;
+    using unsigned_type = uint128_t;
+};
+
+template <std::signed_integral T>
+using wide_signed_t = typename wide_by_size<sizeof(T)>::signed_type;
+template <std::signed_integral T>
+using wide_unsigned_t = typename wide_by_size<sizeof(T)>::unsigned_type;
+
+template <unsigned_word U>
+struct FullProduct {
+    U high;
+    U low;
+
+    constexpr bool operator==(const FullProduct&) const noexcept = default;
+    constexpr auto operator<=>(const FullProduct&) const noexcept = default;
+};
+
+template <unsigned_word U>
+constexpr FullProduct<U> multiply_full(U lhs, U rhs) noexcept
+{
+    using Word = gcd_word_t<U>;
+    constexpr int half = std::numeric_limits<U>::digits / 2;
+    constexpr Word mask = (Word{1} << half) - 1;
+
+    const Word lhs_low = lhs & mask, lhs_high = Word{lhs} >> half;
+    const Word rhs_low = rhs & mask, rhs_high = Word{rhs} >> half;
+    const Word low_low = lhs_low * rhs_low, low_high = lhs_low * rhs_high;
+    const Word high_low = lhs_high * rhs_low, high_high = lhs_high * rhs_high;
+
+    const Word middle = (low_low >> half) + (low_high & mask) + (high_low & mask);
+    return {static_cast<U>(high_high + (low_high >> half) + (high_low >> half) + (middle >> half)),
+        static_cast<U>((middle << half) | (low_low & mask))};
+}
+
+template <unsigned_word U>
+constexpr bool checked_multiply(U lhs, U rhs, U& result) noexcept
+{
+    if (bit_width(lhs) + bit_width(rhs) <= std::numeric_limits<U>::digits) {
+        result = static_cast<U>(lhs * rhs);
+        return true;
+    }
+    const auto product = multiply_full(lhs, rhs);
+    result = product.low;
+    return product.high == 0;
+}
+
+template <unsigned_word W, std::unsigned_integral U>
+constexpr W quotient(W value, U divisor) noexcept
+{
+    if constexpr (sizeof(W) > sizeof(std::uint64_t)) {
+        if (value >> 64 == 0) {
+            return static_cast<std::uint64_t>(value) / divisor;
+        }
+    }
+    return static_cast<W>(value / divisor);
+}
+template <unsigned_word W, std::unsigned_integral U>
+constexpr U remainder(W value, U divisor) noexcept
+{
+    if constexpr (sizeof(W) > sizeof(std::uint64_t)) {
+        if (value >> 64 == 0) {
+            return static_cast<U>(static_cast<std::uint64_t>(value) % divisor);
+        }
+    }
+    return static_cast<U>(value % divisor);
+}
+
+// value / Divisor; compilers already use a multiplicative inverse for native words, so the
+// magic number of Granlund and Montgomery is only computed for the 128-bit word
+template <auto Divisor, unsigned_word W>
+requires(Divisor > 0) constexpr W quotient_by(W value) noexcept
+{
+    if constexpr (!std::same_as<W, uint128_t>) {
+        return static_cast<W>(value / Divisor);
+    } else if constexpr (std::has_single_bit(static_cast<std::uint64_t>(Divisor))) {
+        return value >> std::countr_zero(static_cast<std::uint64_t>(Divisor));
+    } else {
+        constexpr auto divisor = static_cast<uint128_t>(Divisor);
+        constexpr int shift = bit_width(static_cast<uint128_t>(divisor - 1));
+        // floor(2^128 * (2^shift - divisor) / divisor) + 1, by long division
+        constexpr uint128_t magic = [] {
+            uint128_t rest = (uint128_t{1} << shift) - divisor, result = 0;
+            for (int i = 0; i < 128; ++i) {
+                rest <<= 1;
+                result <<= 1;
+                if (rest >= divisor) {
+                    rest -= divisor;
+                    result |= 1;
+                }
+            }
+            return result + 1;
+        }();
+        const auto high = multiply_full(magic, value).high;
+        return (high + ((value - high) >> 1)) >> (shift - 1);
+    }
+}
+
+template <std::signed_integral T>
+struct WideFraction {
+    using Word = wide_unsigned_t<T>;
+
+    bool negative;
+    Word numer;
+    Word denom;
+};
+
+template <std::signed_integral T>
+constexpr bool fits(const WideFraction<T>& value) noexcept
+{
+    using Word = typename WideFraction<T>::Word;
+    constexpr auto max = static_cast<Word>(std::numeric_limits<T>::max());
+    return value.numer <= max + (value.negative ? 1 : 0) && value.denom <= std::numeric_limits<std::make_unsigned_t<T>>::max();
+}
+
+// Best approximation of numer/denom with numerator and denominator bounded by the limits
+template <unsigned_word U>
+constexpr void approximate(U& numer, U& denom, U numer_limit, U denom_limit) noexcept
+{
+    U prev_numer = 0, prev_denom = 1, last_numer = 1, last_denom = 0;
+    U dividend = numer, divisor = denom;
+    while (divisor != 0) {
+        const U term = dividend / divisor, rest = dividend % divisor;
+        const U numer_room = last_numer == 0 ? std::numeric_limits<U>::max() : static_cast<U>((numer_limit - prev_numer) / last_numer);
+        const U denom_room = last_denom == 0 ? std::numeric_limits<U>::max() : static_cast<U>((denom_limit - prev_denom) / last_denom);
+        const U room = numer_room < denom_room ? numer_room : denom_room;
+        if (term > room) {
+            const auto twice = static_cast<U>(2 * room * last_denom + prev_denom);
+            if (last_denom == 0 || (room != 0 && multiply_full(dividend, last_denom) < multiply_full(twice, divisor))) {
+                numer = static_cast<U>(room * last_numer + prev_numer);
+                denom = static_cast<U>(room * last_denom + prev_denom);
+            } else {
+                numer = last_numer;
+                denom = last_denom;
+            }
+            return;
+        }
+
+        const auto next_numer = static_cast<U>(term * last_numer + prev_numer);
+        const auto next_denom = static_cast<U>(term * last_denom + prev_denom);
+        prev_numer = last_numer;
+        prev_denom = last_denom;
+        last_numer = next_numer;
+        last_denom = next_denom;
+        dividend = divisor;
+        divisor = rest;
+    }
+    numer = last_numer;
+    denom = last_denom;
+}
+
+template <std::signed_integral T>
+constexpr void narrow(WideFraction<T> value, T& numer, std::make_unsigned_t<T>& denom) noexcept(nothrow_overflow_v<T>)
+{
+    using Unsigned = std::make_unsigned_t<T>;
+    using Word = typename WideFraction<T>::Word;
+    using Policy = overflow_policy_t<T>;
+
+    if (!fits(value)) [[unlikely]] {
+        if constexpr (std::is_same_v<Policy, ThrowOnOverflow>) {
+            throw std::overflow_error{"result of Rational arithmetic overflows"};
+        } else if constexpr (std::is_same_v<Policy, SaturateOnOverflow>) {
+            approximate(value.numer, value.denom,
+                static_cast<Word>(static_cast<Word>(std::numeric_limits<T>::max()) + (value.negative ? 1 : 0)),
+                static_cast<Word>(std::numeric_limits<Unsigned>::max()));
+        }
+    }
+    numer = with_sign<T>(value.negative && value.numer != 0, static_cast<Unsigned>(value.numer));
+    denom = static_cast<Unsigned>(value.denom);
+}
+
+template <std::signed_integral T>
+constexpr WideFraction<T> signed_sum(bool lhs_negative, wide_unsigned_t<T> lhs, bool rhs_negative, wide_unsigned_t<T> rhs, wide_unsigned_t<T> denom) noexcept
+{
+    if (lhs_negative == rhs_negative) {
+        return {lhs_negative, static_cast<wide_unsigned_t<T>>(lhs + rhs), denom};
+    }
+    if (lhs >= rhs) {
+        return {lhs_negative, static_cast<wide_unsigned_t<T>>(lhs - rhs), denom};
+    }
+    return {rhs_negative, static_cast<wide_unsigned_t<T>>(rhs - lhs), denom};
+}
+
+template <std::signed_integral T>
+constexpr WideFraction<T> wide_sum(T lhs_numer, std::make_unsigned_t<T> lhs_denom, T rhs_numer, std::make_unsigned_t<T> rhs_denom, bool subtract = false) noexcept
+{
+    using Unsigned = std::make_unsigned_t<T>;
+    using Word = wide_unsigned_t<T>;
+
+    const auto gcd = binary_gcd(lhs_denom, rhs_denom);
+    const auto lhs_coeff = static_cast<Unsigned>(lhs_denom / gcd), rhs_coeff = static_cast<Unsigned>(rhs_denom / gcd);
+
+    auto result = signed_sum<T>(lhs_numer < 0, static_cast<Word>(Word{magnitude(lhs_numer)} * rhs_coeff),
+        (rhs_numer < 0) != subtract, static_cast<Word>(Word{magnitude(rhs_numer)} * lhs_coeff), 0);
+    const auto common = gcd == 1 ? gcd : binary_gcd(gcd, remainder(result.numer, gcd));
+    if (common != 1) {
+        result.numer = quotient(result.numer, common);
+    }
+    result.denom = static_cast<Word>(Word{lhs_coeff} * static_cast<Unsigned>(rhs_denom / common));
+    return result;
+}
+template <std::signed_integral T>
+constexpr WideFraction<T> wide_sum(T numer, std::make_unsigned_t<T> denom, T other, bool subtract = false) noexcept
+{
+    using Word = wide_unsigned_t<T>;
+    return signed_sum<T>(numer < 0, magnitude(numer), (other < 0) != subtract, static_cast<Word>(Word{denom} * magnitude(other)), denom);
+}
+
+template <std::signed_integral T>
+constexpr WideFraction<T> wide_product(T lhs_numer, std::make_unsigned_t<T> lhs_denom, T rhs_numer, std::make_unsigned_t<T> rhs_denom) noexcept
+{
+    using Unsigned = std::make_unsigned_t<T>;
+    using Word = wide_unsigned_t<T>;
+
+    const auto lhs_gcd = binary_gcd(magnitude(lhs_numer), rhs_denom);
+    const auto rhs_gcd = binary_gcd(magnitude(rhs_numer), lhs_denom);
+    return {(lhs_numer < 0) != (rhs_numer < 0),
+        static_cast<Word>(Word{static_cast<Unsigned>(magnitude(lhs_numer) / lhs_gcd)} * static_cast<Unsigned>(magnitude(rhs_numer) / rhs_gcd)),
+        static_cast<Word>(Word{static_cast<Unsigned>(lhs_denom / rhs_gcd)} * static_cast<Unsigned>(rhs_denom / lhs_gcd))};
+}
+template <std::signed_integral T>
+constexpr WideFraction<T> wide_product(T numer, std::make_unsigned_t<T> denom, T other) noexcept
+{
+    using Unsigned = std::make_unsigned_t<T>;
+    using Word = wide_unsigned_t<T>;
+
+    const auto gcd = binary_gcd(magnitude(other), denom);
+    return {(numer < 0) != (other < 0),
+        static_cast<Word>(Word{magnitude(numer)} * static_cast<Unsigned>(magnitude(other) / gcd)),
+        static_cast<Unsigned>(denom / gcd)};
+}
+
+template <std::signed_integral T>
+constexpr WideFraction<T> wide_quotient(T lhs_numer, std::make_unsigned_t<T> lhs_denom, T rhs_numer, std::make_unsigned_t<T> rhs_denom) noexcept
+{
+    using Unsigned = std::make_unsigned_t<T>;
+    using Word = wide_unsigned_t<T>;
+
+    const auto numer_gcd = binary_gcd(magnitude(lhs_numer), magnitude(rhs_numer));
+    const auto denom_gcd = binary_gcd(lhs_denom, rhs_denom);
+    return {(lhs_numer < 0) != (rhs_numer < 0),
+        static_cast<Word>(Word{static_cast<Unsigned>(magnitude(lhs_numer) / numer_gcd)} * static_cast<Unsigned>(rhs_denom / denom_gcd)),
+        static_cast<Word>(Word{static_cast<Unsigned>(lhs_denom / denom_gcd)} * static_cast<Unsigned>(magnitude(rhs_numer) / numer_gcd))};
+}
+template <std::signed_integral T>
+constexpr WideFraction<T> wide_quotient(T numer, std::make_unsigned_t<T> denom, T other) noexcept
+{
+    using Unsigned = std::make_unsigned_t<T>;
+    using Word = wide_unsigned_t<T>;
+
+    const auto gcd = binary_gcd(magnitude(numer), magnitude(other));
+    return {(numer < 0) != (other < 0),
+        static_cast<Unsigned>(magnitude(numer) / gcd),
+        static_cast<Word>(Word{denom} * static_cast<Unsigned>(magnitude(other) / gcd))};
+}
+}  // namespace rational::detail
@@ -0,0 +1,192 @@
+#include "big_rational.hpp"
+#include "overflow_policies.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+struct CountingResource : std::pmr::memory_resource {
+    std::size_t allocations = 0;
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+}  // namespace
+
+TEST_CASE("big_integer")
+{
+    using Integer = rational::detail::BigInteger<>;
+
+    std::vector<Integer> fibonacci{Integer{false, 0}, Integer{false, 1}};
+    for (int i = 2; i <= 300; ++i) {
+        fibonacci.push_back(fibonacci[fibonacci.size() - 1] + fibonacci[fibonacci.size() - 2]);
+    }
+    REQUIRE(Integer::gcd(fibonacci[300], fibonacci[200]) == fibonacci[100]);
+    REQUIRE(Integer::gcd(fibonacci[299], fibonacci[300]) == Integer{false, 1});
+    REQUIRE(Integer::gcd(fibonacci[300], Integer{}) == fibonacci[300]);
+
+    std::mt19937_64 engine{0};
+    for (int i = 0; i < 1000; ++i) {
+        Integer dividend{engine() % 2 == 0, engine()}, divisor{false, engine() | 1};
+        for (auto limbs = engine() % 6; limbs-- > 0;) {
+            dividend *= engine();
+        }
+        for (auto limbs = engine() % 4; limbs-- > 0;) {
+            divisor *= engine() | 1;
+        }
+        Integer quotient, remainder;
+        Integer::divide(dividend, divisor, quotient, remainder);
+        REQUIRE(quotient * divisor + remainder == dividend);
+        REQUIRE(Integer::compare_magnitude(remainder, divisor) < 0);
+        REQUIRE(Integer::gcd(dividend * divisor, divisor) == divisor);
+    }
+    REQUIRE_THROWS_AS((Integer{false, 1} / Integer{}), std::range_error);
+}
+
+TEST_CASE("big_rational")
+{
+    constexpr auto max = std::numeric_limits<std::int64_t>::max();
+    constexpr auto min = std::numeric_limits<std::int64_t>::min();
+
+    BigRational a{max};
+    REQUIRE(a.is_inline());
+    a += 1;
+    REQUIRE(!a.is_inline());
+    REQUIRE(a > max);
+    REQUIRE(a == -BigRational{min});
+    a -= 1;
+    REQUIRE(a.is_inline());
+    REQUIRE(a == Rational<std::int64_t>{max});
+
+    REQUIRE(BigRational{min, -1} == -BigRational{min});
+    REQUIRE(!BigRational{min, -1}.is_inline());
+    REQUIRE(BigRational{min, -1} > 0);
+    REQUIRE(BigRational{1, min} == Rational{std::int64_t{-1}, std::uint64_t{1} << 63});
+    REQUIRE(BigRational{1, min}.is_inline());
+    REQUIRE(BigRational{min, 1} == Rational{min});
+    REQUIRE(BigRational{min, 1}.is_inline());
+    REQUIRE(BigRational{-6, -4} == Rational{3, 2});
+    REQUIRE_THROWS_AS((BigRational{1, 0}), std::range_error);
+
+    BigRational b{1, max};
+    b /= max;
+    REQUIRE(!b.is_inline());
+    REQUIRE(b * max * max == 1);
+    REQUIRE((b * max * max).is_inline());
+    REQUIRE(b.inverse() / max == max);
+    REQUIRE(b < Rational{1l, max});
+    REQUIRE(0 < b);
+    REQUIRE(-b < 0);
+
+    BigRational c = Rational<std::int32_t>{1, 3};
+    REQUIRE(c + Rational<std::int16_t>{std::int16_t{2}, std::int16_t{3}} == 1);
+    REQUIRE(Rational<std::int8_t>{std::int8_t{1}, std::int8_t{2}} * c == Rational{1, 6});
+    REQUIRE(2 - c == Rational{5, 3});
+    REQUIRE(1 / c == 3);
+    REQUIRE_THROWS_AS(c / 0, std::range_error);
+    REQUIRE_THROWS_AS(c / BigRational{}, std::range_error);
+    REQUIRE_THROWS_AS(BigRational{}.inverse(), std::range_error);
+
+    BigRational harmonic;
+    for (std::int64_t i = 1; i <= 100; ++i) {
+        harmonic += BigRational{1, i};
+    }
+    REQUIRE(!harmonic.is_inline());
+    REQUIRE(harmonic.denom().bit_width() == 132);
+    REQUIRE(BigRational{harmonic.numer(), harmonic.denom()} == harmonic);
+    REQUIRE(BigRational{harmonic.numer() * harmonic.denom(), harmonic.denom() * harmonic.denom()} == harmonic);
+    auto negated = harmonic.denom();
+    REQUIRE(BigRational{harmonic.numer(), negated.negate()} == -harmonic);
+    REQUIRE(BigRational{BigRational::IntegerType{false, 6}, BigRational::IntegerType{true, 4}} == Rational{-3, 2});
+    REQUIRE(BigRational{BigRational::IntegerType{false, 6}, BigRational::IntegerType{true, 4}}.is_inline());
+    REQUIRE_THROWS_AS((BigRational{harmonic.numer(), BigRational::IntegerType{}}), std::range_error);
+    auto difference = harmonic;
+    for (std::int64_t i = 100; i > 0; --i) {
+        difference -= BigRational{1, i};
+    }
+    REQUIRE(difference == 0);
+    REQUIRE(difference.is_inline());
+    REQUIRE(static_cast<double>(harmonic) > 5.187);
+    REQUIRE(static_cast<double>(harmonic) < 5.188);
+
+    std::hash<BigRational> hash;
+    REQUIRE(hash(harmonic) == hash(harmonic + 1 - 1));
+    REQUIRE(hash(BigRational{1, 3}) == std::hash<Rational<std::int64_t>>{}(Rational{1, 3}));
+}
+
+TEST_CASE("big_rational_random")
+{
+    std::mt19937_64 engine{0};
+    std::uniform_int_distribution<std::int64_t> numer{std::numeric_limits<std::int64_t>::min() + 1, std::numeric_limits<std::int64_t>::max()};
+    std::uniform_int_distribution<std::int64_t> denom{1, std::numeric_limits<std::int64_t>::max()};
+
+    for (int i = 0; i < 1000; ++i) {
+        const BigRational a{numer(engine), denom(engine)}, b{numer(engine), denom(engine)}, c{numer(engine), denom(engine)};
+        const auto x = a * b + c, y = a - b / c;
+        REQUIRE((x - c) / b == a);
+        REQUIRE((a - y) * c == b);
+        REQUIRE(x * y == a * b * a - a * b * b / c + c * a - b);
+        REQUIRE((x <=> y) == (x - y <=> 0));
+    }
+}
+
+TEST_CASE("big_rational_conversion")
+{
+    constexpr auto max = std::numeric_limits<std::int64_t>::max();
+
+    const BigRational small{-1, 3};
+    REQUIRE(static_cast<Rational<std::int64_t>>(small) == Rational{-1, 3});
+    REQUIRE(static_cast<Rational<std::int8_t>>(small) == Rational<std::int8_t>{std::int8_t{-1}, std::int8_t{3}});
+    REQUIRE(static_cast<float>(small) < -0.33f);
+
+    const auto big = BigRational{max} * max / 3;
+    REQUIRE_THROWS_AS(static_cast<Rational<std::int64_t>>(big), std::overflow_error);
+    REQUIRE_THROWS_AS(static_cast<Rational<std::int32_t>>(small * 1'000'000'000'000), std::overflow_error);
+    REQUIRE(static_cast<Rational<long long>>(big) == Rational{std::numeric_limits<long long>::max()});
+    REQUIRE(static_cast<Rational<long long>>(1 + BigRational{1} / max / max) == Rational{1ll});
+    REQUIRE(static_cast<Rational<char>>(BigRational{257, 3}) == Rational<char>{char{1}, char{3}});
+}
+
+TEST_CASE("big_rational_allocator")
+{
+    CountingResource upstream;
+    std::pmr::monotonic_buffer_resource arena{4096, &upstream};
+    const std::pmr::polymorphic_allocator<std::uint64_t> allocator{&arena};
+
+    rational::pmr::BigRational sum{allocator};
+    for (std::int64_t i = 1; i <= 60; ++i) {
+        sum += rational::pmr::BigRational{1, i, allocator};
+    }
+    REQUIRE(!sum.is_inline());
+    REQUIRE(sum.get_allocator().resource() == &arena);
+    REQUIRE(upstream.allocations > 0);
+    REQUIRE(upstream.allocations < 60);
+
+    const auto product = sum * Rational{3, 7};
+    REQUIRE(product.get_allocator().resource() == &arena);
+    REQUIRE(product / sum == Rational{3, 7});
+
+    rational::pmr::BigRational inline_value{1, 3, allocator};
+    inline_value *= 2;
+    REQUIRE(inline_value.is_inline());
+}
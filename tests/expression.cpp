@@ -0,0 +1,119 @@
+#include "rational_expression.hpp"
+#include "overflow_policies.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+template <std::signed_integral T>
+std::vector<Rational<T>> random_rationals(std::mt19937_64& engine, std::size_t size, std::int64_t limit)
+{
+    std::uniform_int_distribution<std::int64_t> numer{-limit, limit}, denom{1, limit};
+    std::vector<Rational<T>> result;
+    for (std::size_t i = 0; i < size; ++i) {
+        result.emplace_back(static_cast<T>(numer(engine)), static_cast<std::make_unsigned_t<T>>(denom(engine)));
+    }
+    return result;
+}
+
+// operator-by-operator reference, or nullopt when some step overflows
+template <std::signed_integral T>
+std::optional<Rational<T>> chained_dot(const std::vector<Rational<T>>& lhs, const std::vector<Rational<T>>& rhs)
+{
+    try {
+        Rational<T> result{0};
+        for (std::size_t i = 0; i < lhs.size(); ++i) {
+            result += lhs[i] * rhs[i];
+        }
+        return result;
+    } catch (const std::overflow_error&) {
+        return std::nullopt;
+    }
+}
+}  // namespace
+
+static_assert(rational::sum(std::array{Rational{1, 2}, Rational{1, 3}, Rational{1, 6}}) == Rational{1});
+static_assert(rational::evaluate(rational::expr(Rational{1, 2}) * Rational{2, 3} - Rational{1, 3}) == Rational{0});
+
+TEST_CASE("sum")
+{
+    constexpr auto max = std::numeric_limits<std::int32_t>::max();
+
+    REQUIRE(rational::sum(std::vector<Rational<int>>{}) == Rational{0});
+
+    std::vector<Rational<std::int64_t>> harmonic;
+    Rational<std::int64_t> chained{0};
+    for (std::int64_t i = 1; i <= 40; ++i) {
+        harmonic.emplace_back(i % 2 == 0 ? -1 : 1, i);
+        chained += harmonic.back();
+    }
+    REQUIRE(rational::sum(harmonic) == chained);
+
+    // Only the result has to fit, not every partial sum
+    const std::vector<Rational<std::int32_t>> cancelling{Rational{max}, Rational{max, 3}, Rational{-max, 3}};
+    REQUIRE_THROWS_AS((Rational{max} + Rational{max, 3}), std::overflow_error);
+    REQUIRE(rational::sum(cancelling) == Rational{max});
+    REQUIRE_THROWS_AS(rational::sum(std::vector{Rational{max}, Rational{1}}), std::overflow_error);
+
+    // Beyond the wide type the sum falls back to the operators
+    std::vector<Rational<std::int16_t>> primes;
+    for (const int prime : {251, 241, 239, 233, 229, 227}) {
+        primes.emplace_back(std::int16_t{1}, static_cast<std::int16_t>(prime));
+    }
+    REQUIRE_THROWS_AS(rational::sum(primes), std::overflow_error);
+
+    const auto saturated = rational::sum(std::vector{Rational{std::numeric_limits<long long>::max()}, Rational{1ll}});
+    REQUIRE(saturated == Rational{std::numeric_limits<long long>::max()});
+}
+
+TEST_CASE("dot")
+{
+    const std::vector a{Rational{1, 2}, Rational{-2, 3}, Rational{3, 4}};
+    const std::vector b{Rational<std::int16_t>{std::int16_t{4}}, Rational<std::int16_t>{std::int16_t{3}, std::int16_t{2}}, Rational<std::int16_t>{std::int16_t{-1}, std::int16_t{6}}};
+    const Rational<int> expected = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    REQUIRE(rational::dot(a, b) == expected);
+    REQUIRE(rational::dot(a, std::vector(b.begin(), b.begin() + 2)) == a[0] * b[0] + a[1] * b[1]);
+
+    std::mt19937_64 engine{0};
+    for (int i = 0; i < 200; ++i) {
+        const auto lhs = random_rationals<std::int32_t>(engine, 8, 1 << (i % 16));
+        const auto rhs = random_rationals<std::int32_t>(engine, 8, 1 << (i % 16));
+        const auto wide_lhs = std::vector<Rational<std::int64_t>>(lhs.begin(), lhs.end());
+        const auto wide_rhs = std::vector<Rational<std::int64_t>>(rhs.begin(), rhs.end());
+        if (const auto chained = chained_dot(lhs, rhs)) {
+            REQUIRE(rational::dot(lhs, rhs) == *chained);
+        } else if (const auto reference = chained_dot(wide_lhs, wide_rhs); reference && reference->numer() == static_cast<std::int32_t>(reference->numer())
+                   && reference->denom() == static_cast<std::uint32_t>(reference->denom())) {
+            REQUIRE(rational::dot(lhs, rhs) == *reference);
+        }
+    }
+}
+
+TEST_CASE("expression")
+{
+    using rational::expr;
+
+    const Rational a{1, 2}, b{2, 3}, c{-3, 4}, d{5, 6}, e{7, 8}, f{9, 10};
+    const Rational<int> fused = expr(a) * b + c * d - e * f;
+    REQUIRE(fused == a * b + c * d - e * f);
+    REQUIRE(rational::evaluate(a - expr(b) * c + d) == a - b * c + d);
+    REQUIRE(rational::evaluate((expr(a) + b) * (expr(c) - d)) == (a + b) * (c - d));
+    REQUIRE(rational::evaluate(expr(a) - (expr(b) * c + d * e)) == a - (b * c + d * e));
+    REQUIRE(rational::evaluate(expr(Rational<std::int16_t>{std::int16_t{1}, std::int16_t{3}}) + a) == Rational{5, 6});
+
+    std::mt19937_64 engine{0};
+    for (int i = 0; i < 1000; ++i) {
+        const auto values = random_rationals<std::int64_t>(engine, 6, 1 << 10);
+        const auto& [p, q, r, s, t, u] = std::array{values[0], values[1], values[2], values[3], values[4], values[5]};
+        REQUIRE(rational::evaluate(expr(p) * q + r * s - t * u) == p * q + r * s - t * u);
+    }
+}
@@ -0,0 +1,151 @@
+#include "fixed_rational.hpp"
+#include "overflow_policies.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+#include <ratio>
+#include <stdexcept>
+#include <type_traits>
+
+namespace
+{
+using Cents = FixedRational<std::int32_t, std::centi>;
+using Pips = FixedRational<std::int64_t, std::ratio<1, 10000>>;
+
+template <auto Divisor>
+void check_quotient_by(std::mt19937_64& engine)
+{
+    using rational::detail::uint128_t;
+    for (int i = 0; i < 10000; ++i) {
+        const auto value = (uint128_t{engine()} << 64 | engine()) >> (i % 128);
+        REQUIRE(rational::detail::quotient_by<Divisor>(value) == value / static_cast<uint128_t>(Divisor));
+    }
+    constexpr auto max = std::numeric_limits<uint128_t>::max();
+    REQUIRE(rational::detail::quotient_by<Divisor>(max) == max / static_cast<uint128_t>(Divisor));
+    REQUIRE(rational::detail::quotient_by<Divisor>(uint128_t{Divisor} - 1) == 0);
+    REQUIRE(rational::detail::quotient_by<Divisor>(uint128_t{Divisor}) == 1);
+}
+
+// a * b / D and a * D / b rounded to nearest even, straight from the wide division
+std::int64_t reference_quotient(rational::detail::int128_t numer, rational::detail::int128_t denom)
+{
+    const auto quotient = numer / denom, rest = numer % denom;
+    const auto twice = 2 * (rest < 0 ? -rest : rest), divisor = denom < 0 ? -denom : denom;
+    const bool up = twice > divisor || (twice == divisor && quotient % 2 != 0);
+    return static_cast<std::int64_t>(up ? quotient + ((numer < 0) != (denom < 0) ? -1 : 1) : quotient);
+}
+}  // namespace
+
+static_assert(sizeof(Cents) * 2 == sizeof(Rational<std::int32_t>));
+static_assert(sizeof(Pips) * 2 == sizeof(Rational<std::int64_t>));
+static_assert(std::is_trivially_copyable_v<Pips> && std::is_standard_layout_v<Pips>);
+static_assert(Cents::denom() == 100);
+static_assert((Cents{Rational{3, 2}} + Cents{1}).numer() == 250);
+static_assert(Cents{Rational{1, 3}} * 3 == Cents{Rational{99, 100}});
+static_assert(Pips{1} * 3 == Pips{3} && 2 * Pips{1} - 1 == Pips{1});
+static_assert(!std::is_invocable_v<std::plus<>, FixedRational<std::int8_t, std::deci>, int>);
+static_assert(!rational::fixed_scale<std::ratio<1, 1000>, std::int8_t>);
+static_assert(!rational::fixed_scale<std::ratio<3, 100>, std::int32_t>);
+
+TEST_CASE("fixed_rational")
+{
+    REQUIRE(Cents{12}.numer() == 1200);
+    REQUIRE(Cents{Rational{1, 3}}.numer() == 33);
+    REQUIRE(Cents{Rational{-2, 3}}.numer() == -67);
+    REQUIRE(Cents{Rational{1, 200}}.numer() == 0);
+    REQUIRE(Cents{Rational{3, 200}}.numer() == 2);
+    REQUIRE(Cents{Rational{-3, 200}}.numer() == -2);
+    REQUIRE(Cents{Rational{5, 200}}.numer() == 2);
+    REQUIRE(Cents::from_numer(150) == Rational{3, 2});
+
+    const auto price = Cents::from_numer(105);
+    REQUIRE((price + price).numer() == 210);
+    REQUIRE((price - Cents{2}).numer() == -95);
+    REQUIRE((-price).numer() == -105);
+    REQUIRE((price * price).numer() == 110);
+    REQUIRE((Cents::from_numer(15) * Cents::from_numer(10)).numer() == 2);
+    REQUIRE((Cents::from_numer(25) * Cents::from_numer(10)).numer() == 2);
+    REQUIRE((Cents::from_numer(-25) * Cents::from_numer(-30)).numer() == 8);
+    REQUIRE((price / Cents{3}).numer() == 35);
+    REQUIRE((price / Cents::from_numer(-200)).numer() == -52);
+    REQUIRE((price + 2).numer() == 305);
+    REQUIRE((price - 2).numer() == -95);
+    REQUIRE((price * -3).numer() == -315);
+    REQUIRE((price / 2).numer() == 52);
+    REQUIRE((Cents::from_numer(107) / 2).numer() == 54);
+    REQUIRE((2 + price).numer() == 305);
+    REQUIRE((2 - price).numer() == 95);
+    REQUIRE((-3 * price).numer() == -315);
+    REQUIRE((2 / Cents::from_numer(400)).numer() == 50);
+
+    const auto pips = Pips::from_numer(12'345);
+    REQUIRE((pips + 1).numer() == 22'345);
+    REQUIRE((pips - 1u).numer() == 2'345);
+    REQUIRE((pips * 3).numer() == 37'035);
+    REQUIRE((pips / 5).numer() == 2'469);
+    REQUIRE((1 + pips) == pips + 1);
+    REQUIRE((1 - pips).numer() == -2'345);
+    REQUIRE((2 * pips) == pips * 2);
+    REQUIRE((1 / Pips{4}).numer() == 2'500);
+
+    REQUIRE(price < Cents{2});
+    REQUIRE(price != Cents{1});
+    REQUIRE(price == Rational{21, 20});
+    const Rational<std::int32_t> widened = price;
+    REQUIRE(widened == Rational{21, 20});
+    REQUIRE(static_cast<int>(price) == 1);
+    REQUIRE(price.to_double() > 1.0499);
+    REQUIRE(price.to_double() < 1.0501);
+    REQUIRE(std::hash<Cents>{}(price) == std::hash<Cents>{}(Cents::from_numer(105)));
+
+    REQUIRE_THROWS_AS(price / Cents{0}, std::range_error);
+    REQUIRE_THROWS_AS(price / 0, std::range_error);
+    REQUIRE_THROWS_AS((FixedRational<std::int8_t, std::deci>{13}), std::overflow_error);
+    REQUIRE_THROWS_AS(-Cents::from_numer(std::numeric_limits<std::int32_t>::min()), std::overflow_error);
+    REQUIRE_THROWS_AS(Cents::from_numer(std::numeric_limits<std::int32_t>::max()) + Cents::from_numer(1), std::overflow_error);
+    REQUIRE_THROWS_AS(Cents{Rational{std::numeric_limits<std::int32_t>::max()}}, std::overflow_error);
+
+    using Saturated = FixedRational<long long, std::milli>;
+    constexpr auto max = std::numeric_limits<long long>::max(), min = std::numeric_limits<long long>::min();
+    REQUIRE(Saturated::from_numer(max) + Saturated::from_numer(1) == Saturated::from_numer(max));
+    REQUIRE(Saturated::from_numer(min) * 2LL == Saturated::from_numer(min));
+    REQUIRE(-Saturated::from_numer(min) == Saturated::from_numer(max));
+    REQUIRE(Saturated{max} == Saturated::from_numer(max));
+}
+
+TEST_CASE("fixed_rational_random")
+{
+    using rational::detail::int128_t;
+
+    std::mt19937_64 engine{0};
+    check_quotient_by<std::uint64_t{3}>(engine);
+    check_quotient_by<std::uint64_t{7}>(engine);
+    check_quotient_by<std::uint64_t{100}>(engine);
+    check_quotient_by<std::uint64_t{10000}>(engine);
+    check_quotient_by<std::uint64_t{1'000'000'000'000'000'000}>(engine);
+    check_quotient_by<(std::uint64_t{1} << 63) + 1>(engine);
+    check_quotient_by<std::numeric_limits<std::uint64_t>::max()>(engine);
+
+    constexpr auto denom = static_cast<int128_t>(Pips::denom());
+    std::uniform_int_distribution<std::int64_t> wide{-(std::int64_t{1} << 40), std::int64_t{1} << 40};
+    std::uniform_int_distribution<std::int64_t> narrow{-(std::int64_t{1} << 20), std::int64_t{1} << 20};
+    for (int i = 0; i < 10000; ++i) {
+        const auto a = wide(engine), b = narrow(engine);
+        const auto lhs = Pips::from_numer(a), rhs = Pips::from_numer(b);
+        REQUIRE((lhs + rhs).numer() == a + b);
+        REQUIRE((lhs * rhs).numer() == reference_quotient(int128_t{a} * b, denom));
+        if (b != 0) {
+            REQUIRE((lhs / rhs).numer() == reference_quotient(int128_t{a} * denom, b));
+            REQUIRE((lhs / b).numer() == reference_quotient(a, b));
+        }
+
+        const Rational<std::int64_t> value{narrow(engine), static_cast<std::uint64_t>(narrow(engine) & 0xffff) + 1};
+        REQUIRE(Pips{value}.numer() == reference_quotient(int128_t{value.numer()} * denom, static_cast<int128_t>(value.denom())));
+        const auto cents = Cents::from_numer(static_cast<std::int32_t>(b)), other = Cents::from_numer(static_cast<std::int32_t>(a >> 30));
+        REQUIRE(cents * other == Cents{Rational<std::int32_t>{cents} * Rational<std::int32_t>{other}});
+    }
+}
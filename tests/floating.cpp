@@ -0,0 +1,172 @@
+#include "big_rational.hpp"
+#include "rational.hpp"
+#include "overflow_policies.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+
+namespace
+{
+template <std::floating_point F>
+bool identical(F lhs, F rhs)
+{
+    using Bits = std::conditional_t<sizeof(F) == sizeof(std::uint32_t), std::uint32_t, std::uint64_t>;
+    return std::bit_cast<Bits>(lhs) == std::bit_cast<Bits>(rhs);
+}
+
+template <std::floating_point F>
+BigRational exact(F value)
+{
+    int exponent;
+    const auto fraction = std::frexp(value, &exponent);
+    BigRational result{static_cast<std::int64_t>(std::ldexp(fraction, 60))};
+    for (exponent -= 60; exponent > 0; exponent -= std::min(exponent, 62)) {
+        result *= std::int64_t{1} << std::min(exponent, 62);
+    }
+    for (; exponent < 0; exponent += std::min(-exponent, 62)) {
+        result /= std::int64_t{1} << std::min(-exponent, 62);
+    }
+    return result;
+}
+
+// value rounds to result, to nearest even
+template <std::floating_point F, std::signed_integral T>
+void check_rounding(const Rational<T>& value, F result)
+{
+    constexpr auto infinity = std::numeric_limits<F>::infinity();
+    const BigRational exact_value{value}, exact_result = exact(result);
+    BigRational lower = exact(std::nextafter(result, -infinity)), upper = exact(std::nextafter(result, infinity));
+    lower += exact_result;
+    lower /= 2;
+    upper += exact_result;
+    upper /= 2;
+    REQUIRE(lower <= exact_value);
+    REQUIRE(exact_value <= upper);
+    if (exact_value == lower || exact_value == upper) {
+        int exponent;
+        const auto mantissa = static_cast<std::int64_t>(std::ldexp(std::frexp(result, &exponent), std::numeric_limits<F>::digits));
+        REQUIRE(mantissa % 2 == 0);
+    }
+}
+
+// Brute force nearest fraction, preferring the smaller denominator on ties
+BigRational nearest(double value, std::int64_t max_denominator)
+{
+    const auto exact_value = exact(value);
+    BigRational best{std::llround(value)}, best_error = best;
+    best_error -= exact_value;
+    best_error = best_error < BigRational{0} ? -best_error : best_error;
+    for (std::int64_t denom = 2; denom <= max_denominator; ++denom) {
+        for (const auto numer : {std::floor(value * static_cast<double>(denom)), std::ceil(value * static_cast<double>(denom))}) {
+            BigRational candidate{static_cast<std::int64_t>(numer), denom}, error = candidate;
+            error -= exact_value;
+            error = error < BigRational{0} ? -error : error;
+            if (error < best_error) {
+                best = candidate;
+                best_error = error;
+            }
+        }
+    }
+    return best;
+}
+}  // namespace
+
+static_assert(Rational<int>::from_floating(-0.75) == Rational{-3, 4});
+static_assert(Rational<int>::from_floating(Rational{1, 3}.to_double(), 10) == Rational{1, 3});
+static_assert(Rational<std::int64_t>::from_floating(std::numbers::pi, 1000) == Rational{std::int64_t{355}, std::uint64_t{113}});
+static_assert(Rational<std::int64_t>::from_floating(Rational{std::numeric_limits<std::int64_t>::max(), std::uint64_t{3}}.to_double()).denom() == 1);
+
+TEST_CASE("to_floating")
+{
+    REQUIRE(identical(Rational{1, 3}.to_double(), 1.0 / 3.0));
+    REQUIRE(identical(Rational{-1, 3}.to_float(), -1.0f / 3.0f));
+    REQUIRE(identical(Rational{0}.to_double(), 0.0));
+    REQUIRE(identical(static_cast<double>(Rational{5, 4}), 1.25));
+
+    // 2^53 + 1 is not a double; rounding it first and dividing after is off by one ulp
+    constexpr auto max = std::numeric_limits<std::uint64_t>::max();
+    const Rational<std::int64_t> inexact{std::int64_t{9007199254740993}, std::uint64_t{7}};
+    check_rounding(inexact, inexact.to_double());
+    REQUIRE(!identical(inexact.to_double(), 9007199254740993.0 / 7.0));
+    check_rounding(inexact, static_cast<double>(inexact));
+
+    // ties between two doubles round to even
+    const Rational<std::int64_t> tie_even{(std::int64_t{1} << 53) + 1}, tie_odd{(std::int64_t{1} << 53) + 3};
+    REQUIRE(identical(tie_even.to_double(), 9007199254740992.0));
+    REQUIRE(identical(tie_odd.to_double(), 9007199254740996.0));
+    REQUIRE(identical(Rational<std::int64_t>{std::numeric_limits<std::int64_t>::min()}.to_double(), -9223372036854775808.0));
+    REQUIRE(identical(Rational<std::int64_t>{std::numeric_limits<std::int64_t>::min(), max}.to_float(), -0.5f));
+
+    std::mt19937_64 engine{0};
+    std::uniform_int_distribution<std::int64_t> numer{std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max()};
+    std::uniform_int_distribution<std::uint64_t> denom{1, max};
+    for (int i = 0; i < 2000; ++i) {
+        const Rational<std::int64_t> value{numer(engine) >> (i % 64), denom(engine) >> (i / 2 % 64) | 1};
+        check_rounding(value, value.to_double());
+        check_rounding(value, value.to_float());
+        const Rational<std::int64_t> binary{value.numer(), std::uint64_t{1} << (i % 64)};
+        check_rounding(binary, binary.to_double());
+        check_rounding(binary, binary.to_float());
+        const Rational<std::int32_t> small{static_cast<std::int32_t>(value.numer() >> 32), static_cast<std::uint32_t>(value.denom() >> 32 | 1)};
+        check_rounding(small, small.to_float());
+        check_rounding(small, small.to_double());
+    }
+}
+
+TEST_CASE("from_floating")
+{
+    REQUIRE(Rational<int>::from_floating(0.5) == Rational{1, 2});
+    REQUIRE(Rational<int>::from_floating(-3.0) == Rational{-3});
+    REQUIRE(Rational<int>::from_floating(-0.0) == Rational{0});
+    REQUIRE(Rational<int>::from_floating(0.1f, 10) == Rational{1, 10});
+    REQUIRE(Rational<std::int64_t>::from_floating(0.1) == Rational{std::int64_t{3602879701896397}, std::int64_t{36028797018963968}});
+    REQUIRE(Rational<std::int64_t>::from_floating(0.1, 1'000'000) == Rational{std::int64_t{1}, std::int64_t{10}});
+    REQUIRE(Rational<std::int64_t>::from_floating(std::numbers::pi, 100) == Rational{std::int64_t{311}, std::int64_t{99}});
+    REQUIRE(Rational<std::int64_t>::from_floating(std::numbers::pi, 1) == Rational{std::int64_t{3}});
+    REQUIRE(Rational<std::int64_t>::from_floating(0.3, 1) == Rational{std::int64_t{0}});
+    REQUIRE(Rational<std::int64_t>::from_floating(0.7, 1) == Rational{std::int64_t{1}});
+
+    // bounded by DenominatorType
+    constexpr auto max = std::numeric_limits<std::uint64_t>::max();
+    REQUIRE(Rational<std::int64_t>::from_floating(5e-20) == Rational<std::int64_t>{std::int64_t{1}, max});
+    REQUIRE(Rational<std::int64_t>::from_floating(2e-20) == Rational{std::int64_t{0}});
+    REQUIRE(Rational<std::int64_t>::from_floating(std::numeric_limits<double>::denorm_min()) == Rational{std::int64_t{0}});
+    REQUIRE(Rational<std::int8_t>::from_floating(0.004) == Rational<std::int8_t>{std::int8_t{1}, std::uint8_t{250}});
+    REQUIRE(Rational<std::int8_t>::from_floating(-128.0) == Rational<std::int8_t>{std::int8_t{-128}});
+    REQUIRE(Rational<std::int8_t>::from_floating(127.6) == Rational<std::int8_t>{std::int8_t{127}});
+    REQUIRE(Rational<std::int64_t>::from_floating(-9223372036854775808.0) == Rational{std::numeric_limits<std::int64_t>::min()});
+
+    REQUIRE_THROWS_AS(Rational<std::int8_t>::from_floating(128.0), std::overflow_error);
+    REQUIRE_THROWS_AS(Rational<std::int64_t>::from_floating(9223372036854775808.0), std::overflow_error);
+    REQUIRE_THROWS_AS(Rational<std::int64_t>::from_floating(1e300), std::overflow_error);
+    REQUIRE(Rational<long long>::from_floating(1e300) == Rational{std::numeric_limits<long long>::max()});
+    REQUIRE(Rational<long long>::from_floating(-1e300) == Rational{std::numeric_limits<long long>::min()});
+    REQUIRE_THROWS_AS(Rational<int>::from_floating(std::numeric_limits<double>::quiet_NaN()), std::domain_error);
+    REQUIRE_THROWS_AS(Rational<int>::from_floating(-std::numeric_limits<float>::infinity()), std::domain_error);
+    REQUIRE_THROWS_AS(Rational<int>::from_floating(0.5, 0), std::range_error);
+
+    std::mt19937_64 engine{0};
+    std::uniform_real_distribution<double> real{-4.0, 4.0};
+    std::uniform_int_distribution<std::int64_t> max_denominator{1, 40};
+    for (int i = 0; i < 300; ++i) {
+        const auto value = real(engine);
+        const auto limit = max_denominator(engine);
+        REQUIRE(BigRational{Rational<std::int64_t>::from_floating(value, static_cast<std::uint64_t>(limit))} == nearest(value, limit));
+    }
+
+    // a double identifies any fraction with small enough terms
+    std::uniform_int_distribution<std::int32_t> denom{1, 1 << 20};
+    for (int i = 0; i < 1000; ++i) {
+        const auto d = denom(engine);
+        const Rational<std::int32_t> value{std::uniform_int_distribution<std::int32_t>{-d, d}(engine), d};
+        REQUIRE(Rational<std::int32_t>::from_floating(value.to_double(), value.denom()) == value);
+        REQUIRE(Rational<std::int32_t>::from_floating(value.to_double(), static_cast<std::uint32_t>(d) + 1000) == value);
+    }
+}
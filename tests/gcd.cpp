@@ -0,0 +1,62 @@
+#include "rational.hpp"
+#include "overflow_policies.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+
+TEST_CASE("binary_gcd")
+{
+    using rational::detail::binary_gcd;
+
+    REQUIRE(binary_gcd(0u, 0u) == 0u);
+    REQUIRE(binary_gcd(0u, 6u) == 6u);
+    REQUIRE(binary_gcd(6u, 0u) == 6u);
+    REQUIRE(binary_gcd(12u, 18u) == 6u);
+    REQUIRE(binary_gcd(std::uint8_t{128}, std::uint8_t{192}) == std::uint8_t{64});
+    REQUIRE(binary_gcd(std::uint64_t{1} << 63, std::uint64_t{3} << 62) == std::uint64_t{1} << 62);
+
+    std::mt19937_64 engine{0};
+    for (int i = 0; i < 1000; ++i) {
+        const auto a = engine(), b = engine() >> (i % 64);
+        REQUIRE(binary_gcd(a, b) == std::gcd(a, b));
+        const auto c = static_cast<std::uint16_t>(a), d = static_cast<std::uint16_t>(b);
+        REQUIRE(binary_gcd(c, d) == std::gcd(c, d));
+    }
+}
+
+TEST_CASE("reduce")
+{
+    using rational::detail::reduce;
+
+    std::int8_t numer = -128;
+    std::uint8_t denom = 128;
+    reduce(numer, denom);
+    REQUIRE(numer == -1);
+    REQUIRE(denom == 1);
+
+    std::int64_t numer64 = std::numeric_limits<std::int64_t>::min();
+    std::uint64_t denom64 = 6;
+    reduce(numer64, denom64);
+    REQUIRE(numer64 == std::numeric_limits<std::int64_t>::min() / 2);
+    REQUIRE(denom64 == 3);
+
+    REQUIRE(Rational<std::int8_t>{-128, std::uint8_t{192}} == Rational<std::int8_t>{-2, std::uint8_t{3}});
+}
+
+TEST_CASE("cross_cancellation")
+{
+    using Rational64 = Rational<std::int64_t>;
+    constexpr std::int64_t big = std::int64_t{1} << 40;
+
+    REQUIRE(Rational64{big, 3l} * Rational64{3l, big} == Rational64{1l});
+    REQUIRE(Rational64{-big, 7l} * Rational64{14l, big} == Rational64{-2l});
+    REQUIRE(Rational64{1l, big} + Rational64{-1l, big} == Rational64{0l});
+    REQUIRE(Rational64{1l, big} + Rational64{1l, big} == Rational64{1l, big / 2});
+    REQUIRE(Rational64{3l, big} * big == Rational64{3l});
+
+    REQUIRE(Rational<std::int8_t>{std::int8_t{64}, std::int8_t{3}} * Rational<std::int8_t>{std::int8_t{3}, std::int8_t{64}} == Rational<std::int8_t>{std::int8_t{1}});
+}
@@ -0,0 +1,186 @@
+#include "rational_io.hpp"
+#include "overflow_policies.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#if defined(__cpp_lib_format)
+#include <format>
+#endif
+
+namespace
+{
+template <std::signed_integral T>
+std::string format(const Rational<T>& value)
+{
+    char buffer[rational::max_chars<T>];
+    const auto result = rational::to_chars(buffer, buffer + sizeof(buffer), value);
+    REQUIRE(result.ec == std::errc{});
+    return std::string(buffer, result.ptr);
+}
+
+template <std::signed_integral T>
+Rational<T> parse(std::string_view text, std::size_t consumed = std::string_view::npos)
+{
+    Rational<T> value{0};
+    const auto result = rational::from_chars(text.data(), text.data() + text.size(), value);
+    REQUIRE(result.ec == std::errc{});
+    REQUIRE(static_cast<std::size_t>(result.ptr - text.data()) == std::min(consumed, text.size()));
+    return value;
+}
+
+template <std::signed_integral T>
+std::errc parse_error(std::string_view text)
+{
+    Rational<T> value{0};
+    return rational::from_chars(text.data(), text.data() + text.size(), value).ec;
+}
+
+template <std::signed_integral T>
+void check_round_trip(std::mt19937_64& engine)
+{
+    using Unsigned = std::make_unsigned_t<T>;
+    std::uniform_int_distribution<std::int64_t> numer{std::numeric_limits<T>::min(), std::numeric_limits<T>::max()};
+    std::uniform_int_distribution<std::uint64_t> denom{1, std::numeric_limits<Unsigned>::max()};
+    for (int i = 0; i < 1000; ++i) {
+        const Rational<T> value{static_cast<T>(numer(engine) >> (i % 64)), static_cast<Unsigned>(denom(engine) >> (i % 64) | 1)};
+        REQUIRE(parse<T>(format(value)) == value);
+    }
+    REQUIRE(parse<T>(format(Rational<T>{std::numeric_limits<T>::min(), std::numeric_limits<Unsigned>::max()}))
+            == Rational<T>{std::numeric_limits<T>::min(), std::numeric_limits<Unsigned>::max()});
+}
+}  // namespace
+
+static_assert([] {
+    constexpr std::string_view text = "-12.50";
+    Rational<int> value{0};
+    rational::from_chars(text.data(), text.data() + text.size(), value);
+    return value;
+}() == Rational{-25, 2});
+
+TEST_CASE("to_chars")
+{
+    REQUIRE(format(Rational{1, 2}) == "1/2");
+    REQUIRE(format(Rational{-3}) == "-3");
+    REQUIRE(format(Rational<std::int8_t>{std::int8_t{-128}, std::uint8_t{255}}) == "-128/255");
+    REQUIRE(format(Rational{std::numeric_limits<std::int64_t>::min() + 1, std::numeric_limits<std::uint64_t>::max()}).size() == rational::max_chars<std::int64_t>);
+
+    char buffer[4];
+    REQUIRE(rational::to_chars(buffer, buffer + 3, Rational{12, 5}).ec == std::errc::value_too_large);
+    REQUIRE(rational::to_chars(buffer, buffer + 2, Rational{12, 5}).ec == std::errc::value_too_large);
+    REQUIRE(rational::to_chars(buffer, buffer + 4, Rational{12, 5}).ptr == buffer + 4);
+}
+
+TEST_CASE("from_chars")
+{
+    REQUIRE(parse<int>("3/4") == Rational{3, 4});
+    REQUIRE(parse<int>("-6/8") == Rational{-3, 4});
+    REQUIRE(parse<int>("6/-8") == Rational{-3, 4});
+    REQUIRE(parse<int>("12") == Rational{12});
+    REQUIRE(parse<int>("-12.50") == Rational{-25, 2});
+    REQUIRE(parse<int>("0.001") == Rational{1, 1000});
+    REQUIRE(parse<int>("1.5e-3") == Rational{3, 2000});
+    REQUIRE(parse<int>("2.5E2") == Rational{250});
+    REQUIRE(parse<int>("1e+3") == Rational{1000});
+    REQUIRE(parse<int>(".5") == Rational{1, 2});
+    REQUIRE(parse<int>("5.") == Rational{5});
+    REQUIRE(parse<int>("0e99999999999999999999") == Rational{0});
+    REQUIRE(parse<int>("1.000000000000000000000000000000000000000000") == Rational{1});
+    REQUIRE(parse<int>("1/2 3/4", 3) == Rational{1, 2});
+    REQUIRE(parse<int>("3/x", 1) == Rational{3});
+    REQUIRE(parse<int>("3e", 1) == Rational{3});
+    REQUIRE(parse<std::int8_t>("-128") == Rational<std::int8_t>{std::int8_t{-128}});
+    REQUIRE(parse<std::int8_t>("-1/128") == Rational<std::int8_t>{std::int8_t{-1}, std::uint8_t{128}});
+    REQUIRE(parse<std::int8_t>("1/-128") == Rational<std::int8_t>{std::int8_t{-1}, std::uint8_t{128}});
+    REQUIRE(parse<std::int8_t>("127/-1") == Rational<std::int8_t>{std::int8_t{-127}});
+    REQUIRE(parse<std::int8_t>("-128/1") == Rational<std::int8_t>{std::int8_t{-128}});
+    REQUIRE(parse<std::int8_t>("254/2") == Rational<std::int8_t>{std::int8_t{127}});
+    REQUIRE(parse<std::int8_t>("-256/2") == Rational<std::int8_t>{std::int8_t{-128}});
+    REQUIRE(parse<std::int8_t>("2/256") == Rational<std::int8_t>{std::int8_t{1}, std::uint8_t{128}});
+    REQUIRE(parse<std::int8_t>("0/1000") == Rational<std::int8_t>{std::int8_t{0}});
+    REQUIRE(parse<std::int8_t>("254/2") == parse<std::int8_t>("127.0"));
+    REQUIRE(parse<std::int64_t>("1/-9223372036854775808") == Rational{std::int64_t{-1}, std::uint64_t{1} << 63});
+    REQUIRE(parse<std::int8_t>("0.25") == Rational<std::int8_t>{std::int8_t{1}, std::uint8_t{4}});
+
+    REQUIRE(parse_error<int>("") == std::errc::invalid_argument);
+    REQUIRE(parse_error<int>("-") == std::errc::invalid_argument);
+    REQUIRE(parse_error<int>(".") == std::errc::invalid_argument);
+    REQUIRE(parse_error<int>("/2") == std::errc::invalid_argument);
+    REQUIRE(parse_error<int>("2147483648") == std::errc::result_out_of_range);
+    REQUIRE(parse_error<int>("-2147483648") == std::errc{});
+    REQUIRE(parse_error<int>("1/4294967296") == std::errc::result_out_of_range);
+    REQUIRE(parse_error<std::int8_t>("-128/-1") == std::errc::result_out_of_range);
+    REQUIRE(parse_error<std::int8_t>("256/2") == std::errc::result_out_of_range);
+    REQUIRE(parse_error<std::int8_t>("1/512") == std::errc::result_out_of_range);
+    REQUIRE(parse_error<std::int64_t>("-9223372036854775808/-1") == std::errc::result_out_of_range);
+    REQUIRE(parse_error<int>("0.1e-100") == std::errc::result_out_of_range);
+    REQUIRE(parse_error<int>("1e10") == std::errc::result_out_of_range);
+    REQUIRE(parse_error<std::int8_t>("1.28e2") == std::errc::result_out_of_range);
+    REQUIRE_THROWS_AS(parse<int>("1/0"), std::range_error);
+
+    std::mt19937_64 engine{0};
+    check_round_trip<std::int8_t>(engine);
+    check_round_trip<std::int16_t>(engine);
+    check_round_trip<std::int32_t>(engine);
+    check_round_trip<std::int64_t>(engine);
+}
+
+TEST_CASE("binary_stream")
+{
+    std::mt19937_64 engine{0};
+    std::uniform_int_distribution<std::int64_t> step{-50, 50};
+    std::vector<Rational<std::int64_t>> prices{Rational{std::numeric_limits<std::int64_t>::min()}, Rational{std::numeric_limits<std::int64_t>::max(), std::int64_t{3}}};
+    for (std::int64_t price = 1'000'000; prices.size() < 1000; price += step(engine)) {
+        prices.emplace_back(price, std::int64_t{100});
+    }
+
+    std::size_t plain_size = 0;
+    for (const auto encoding : {rational::BinaryEncoding::plain, rational::BinaryEncoding::delta}) {
+        std::vector<std::byte> bytes;
+        rational::BinaryWriter<std::int64_t> writer{encoding};
+        for (const auto& price : prices) {
+            const auto size = bytes.size();
+            writer.write(std::back_inserter(bytes), price);
+            REQUIRE(bytes.size() - size <= writer.max_size);
+        }
+
+        rational::BinaryReader<std::int64_t> reader{bytes, encoding};
+        for (const auto& price : prices) {
+            REQUIRE(reader.next() == price);
+        }
+        REQUIRE(reader.empty());
+        REQUIRE(reader.position() == bytes.size());
+        REQUIRE(!reader.next());
+
+        if (encoding == rational::BinaryEncoding::plain) {
+            plain_size = bytes.size();
+        } else {
+            REQUIRE(bytes.size() < plain_size);
+        }
+    }
+
+    const std::vector<std::byte> truncated{std::byte{0x02}, std::byte{0x80}};
+    REQUIRE_THROWS_AS(rational::BinaryReader<int>{truncated}.next(), std::invalid_argument);
+    const std::vector<std::byte> overlong{std::byte{0x02}, std::byte{0xff}, std::byte{0xff}, std::byte{0xff}, std::byte{0xff}, std::byte{0x1f}};
+    REQUIRE_THROWS_AS(rational::BinaryReader<int>{overlong}.next(), std::invalid_argument);
+    const std::vector<std::byte> zero{std::byte{0x02}, std::byte{0x00}};
+    REQUIRE_THROWS_AS(rational::BinaryReader<int>{zero}.next(), std::range_error);
+}
+
+#if defined(__cpp_lib_format)
+TEST_CASE("format")
+{
+    REQUIRE(std::format("{}", Rational{-1, 2}) == "-1/2");
+    REQUIRE(std::format("[{:>6}]", Rational{3}) == "[     3]");
+}
+#endif
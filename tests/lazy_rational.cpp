@@ -0,0 +1,96 @@
+#include "lazy_rational.hpp"
+#include "overflow_policies.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <compare>
+#include <cstdint>
+#include <functional>
+#include <unordered_set>
+
+TEST_CASE("lazy_construct")
+{
+    REQUIRE_NOTHROW(LazyRational{2, 3});
+    REQUIRE_NOTHROW(LazyRational{2, 3u});
+    REQUIRE_THROWS(LazyRational{2, 0});
+
+    LazyRational a{4, 6};
+    REQUIRE_FALSE(a.reduced());
+    REQUIRE(a.numer() == 2);
+    REQUIRE(a.denom() == 3u);
+    REQUIRE(a.normalize().reduced());
+
+    REQUIRE(LazyRational{-4, -2} == Rational{2});
+    REQUIRE(LazyRational{4, -2} == Rational{-2});
+    REQUIRE(LazyRational{0, 5} == Rational{0});
+}
+
+TEST_CASE("lazy_compare")
+{
+    REQUIRE(LazyRational{2, 6} == LazyRational{1, 3});
+    REQUIRE(LazyRational{2, 6} != LazyRational{2, 5});
+    REQUIRE(LazyRational{2, 6} < LazyRational{4, 10});
+    REQUIRE(LazyRational{4, 10} > LazyRational{2, 6});
+    REQUIRE(LazyRational{2, 6} <= LazyRational{1, 3});
+    REQUIRE(LazyRational{2, 6} >= LazyRational{1, 3});
+    REQUIRE(LazyRational{2, 6} < Rational{2, 5});
+    REQUIRE(Rational{2, 5} > LazyRational{2, 6});
+    REQUIRE(LazyRational{2, 6} >= Rational{1, 3});
+    REQUIRE(Rational{1, 3} <= LazyRational{2, 6});
+    REQUIRE((LazyRational{2, 6} <=> Rational{1, 3}) == std::strong_ordering::equal);
+    REQUIRE((Rational{1, 2} <=> LazyRational{2, 6}) == std::strong_ordering::greater);
+    REQUIRE(Rational{1, 3} == LazyRational{2, 6});
+    REQUIRE(Rational{1, 2} != LazyRational{2, 6});
+    REQUIRE(LazyRational{2, 6} != Rational{1, 2});
+
+    REQUIRE(std::hash<LazyRational<int>>{}(LazyRational{2, 6}) == std::hash<Rational<int>>{}(Rational{1, 3}));
+    std::unordered_set<LazyRational<int>> set{LazyRational{2, 6}, LazyRational{3, 9}, LazyRational{1, 2}};
+    REQUIRE(set.size() == 2);
+}
+
+TEST_CASE("lazy_ops")
+{
+    REQUIRE(LazyRational{1, 3} + LazyRational{1, 6} == Rational{1, 2});
+    REQUIRE(LazyRational{1, 2} - LazyRational{1, 3} == Rational{1, 6});
+    REQUIRE(LazyRational{-1, 4} * LazyRational{2, 3} == Rational{-1, 6});
+    REQUIRE(LazyRational{1, 4} / LazyRational{-3, 2} == Rational{-1, 6});
+    REQUIRE_THROWS(LazyRational{1} / LazyRational{0});
+
+    REQUIRE(LazyRational{1, 3} + 1 == Rational{4, 3});
+    REQUIRE(LazyRational{1, 2} - 1 == Rational{-1, 2});
+    REQUIRE(LazyRational{1, 4} * -2 == Rational{-1, 2});
+    REQUIRE(LazyRational{9, 4} / -6 == Rational{-3, 8});
+    REQUIRE_THROWS(LazyRational{1} / 0);
+
+    REQUIRE(-LazyRational{2, 6} == Rational{-1, 3});
+    REQUIRE(LazyRational{-2, 6}.inverse() == Rational{-3});
+    REQUIRE_THROWS(LazyRational{0}.inverse());
+}
+
+TEST_CASE("lazy_accumulate")
+{
+    LazyRational<std::int64_t> lazy{0l};
+    Rational<std::int64_t> eager{0l};
+    for (std::int64_t i = 1; i <= 30; ++i) {
+        lazy += LazyRational{1l, i};
+        eager += Rational{1l, i};
+        REQUIRE(lazy == eager);
+    }
+
+    LazyRational<std::int8_t> small{std::int8_t{0}};
+    for (int i = 0; i < 40; ++i) {
+        small += LazyRational<std::int8_t>{std::int8_t{1}, std::int8_t{4}};
+    }
+    REQUIRE(small == Rational<std::int8_t>{std::int8_t{10}});
+
+    LazyRational<std::int16_t> product{std::int16_t{1}};
+    for (std::int16_t i = 1; i <= 12; ++i) {
+        product *= LazyRational<std::int16_t>{static_cast<std::int16_t>(i + 1), i};
+    }
+    REQUIRE(product == Rational<std::int16_t>{std::int16_t{13}});
+}
+
+static_assert([] {
+    const LazyRational a{2, 4};
+    return a.numer() == 1 && static_cast<Rational<int>>(a + LazyRational{1, 4}) == Rational{3, 4};
+}());
@@ -1,4 +1,5 @@
 #include "rational.hpp"
+#include "overflow_policies.hpp"
 
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
@@ -0,0 +1,192 @@
+#include "rational_matrix.hpp"
+#include "overflow_policies.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+using Matrix = RationalMatrix<std::int64_t>;
+using Value = Rational<std::int64_t>;
+
+Value fraction(std::int64_t numer, std::int64_t denom)
+{
+    return Value{numer, denom};
+}
+
+// L * U with unit diagonal in L, so the determinant is the product of the diagonal of U while the
+// entries of the elimination grow well past 128 bits
+Matrix unimodular_product(std::size_t size, std::mt19937_64& engine)
+{
+    std::uniform_int_distribution<std::int64_t> entry{-100, 100};
+    Matrix lower{size, size}, upper{size, size};
+    for (std::size_t i = 0; i < size; ++i) {
+        lower(i, i) = Value{1};
+        upper(i, i) = Value{i % 3 == 0 ? -1 : 1};
+        for (std::size_t j = 0; j < i; ++j) {
+            lower(i, j) = Value{entry(engine)};
+            upper(j, i) = Value{entry(engine)};
+        }
+    }
+    return lower * upper;
+}
+
+void check_solution(const Matrix& matrix, const std::vector<Value>& solution, const std::vector<Value>& rhs)
+{
+    REQUIRE(solution.size() == rhs.size());
+    for (std::size_t i = 0; i < matrix.rows(); ++i) {
+        REQUIRE(rational::dot(matrix.row(i), solution) == rhs[i]);
+    }
+}
+}  // namespace
+
+TEST_CASE("matrix")
+{
+    const Matrix matrix{{Value{1}, Value{2}}, {Value{3}, Value{4}}};
+    REQUIRE(matrix.rows() == 2);
+    REQUIRE(matrix.cols() == 2);
+    REQUIRE(matrix(1, 0) == Value{3});
+    REQUIRE(matrix.row(1).size() == 2);
+    REQUIRE(matrix.row(1)[1] == Value{4});
+    REQUIRE(matrix.values().size() == 4);
+    REQUIRE(matrix * Matrix::identity(2) == matrix);
+    REQUIRE(matrix * matrix == Matrix{{Value{7}, Value{10}}, {Value{15}, Value{22}}});
+    REQUIRE(matrix != Matrix::identity(2));
+    REQUIRE(Matrix{}.empty());
+
+    REQUIRE(matrix.determinant() == Value{-2});
+    REQUIRE(matrix.rank() == 2);
+    REQUIRE(matrix.inverse() == Matrix{{Value{-2}, Value{1}}, {fraction(3, 2), fraction(-1, 2)}});
+    REQUIRE(matrix.solve(std::vector{Value{5}, Value{6}}) == std::vector{Value{-4}, fraction(9, 2)});
+    REQUIRE(Matrix{}.determinant() == Value{1});
+    REQUIRE(Matrix{}.inverse().empty());
+
+    Matrix hilbert{5, 5};
+    for (std::size_t i = 0; i < 5; ++i) {
+        for (std::size_t j = 0; j < 5; ++j) {
+            hilbert(i, j) = fraction(1, static_cast<std::int64_t>(i + j + 1));
+        }
+    }
+    REQUIRE(hilbert.determinant() == fraction(1, 266'716'800'000));
+    const auto inverse = hilbert.inverse();
+    REQUIRE(inverse(0, 0) == Value{25});
+    REQUIRE(inverse(4, 4) == Value{44'100});
+    REQUIRE(hilbert * inverse == Matrix::identity(5));
+    REQUIRE(inverse * hilbert == Matrix::identity(5));
+
+    // the first column needs a row swap, and the swap flips the sign
+    const Matrix swapped{{Value{0}, Value{1}, Value{2}}, {Value{1}, Value{0}, Value{3}}, {Value{4}, Value{-3}, Value{8}}};
+    REQUIRE(swapped.determinant() == Value{-2});
+    check_solution(swapped, swapped.solve(std::vector{Value{1}, Value{2}, Value{3}}), {Value{1}, Value{2}, Value{3}});
+
+    const Matrix singular{{Value{1}, Value{2}, Value{3}}, {Value{4}, Value{5}, Value{6}}, {Value{7}, Value{8}, Value{9}}};
+    REQUIRE(singular.determinant() == Value{0});
+    REQUIRE(singular.rank() == 2);
+    REQUIRE(Matrix{{Value{0}, Value{1}, Value{2}}, {Value{0}, Value{2}, Value{4}}, {Value{0}, Value{0}, Value{1}}}.rank() == 2);
+    REQUIRE(Matrix{{Value{1}, Value{2}, Value{3}, Value{4}}, {Value{2}, Value{4}, Value{6}, Value{8}}}.rank() == 1);
+    REQUIRE(Matrix{3, 2}.rank() == 0);
+    REQUIRE(Matrix{{fraction(1, 3), fraction(1, 2)}, {fraction(2, 3), Value{1}}}.rank() == 1);
+
+    REQUIRE_THROWS_AS(singular.inverse(), std::range_error);
+    REQUIRE_THROWS_AS(singular.solve(std::vector{Value{1}, Value{2}, Value{3}}), std::range_error);
+    REQUIRE_THROWS_AS((Matrix{2, 3}.determinant()), std::invalid_argument);
+    REQUIRE_THROWS_AS(matrix.solve(std::vector{Value{1}}), std::invalid_argument);
+    REQUIRE_THROWS_AS((matrix * Matrix{3, 1}), std::invalid_argument);
+    REQUIRE_THROWS_AS((Matrix{{Value{1}, Value{2}}, {Value{3}}}), std::invalid_argument);
+
+    using Small = Rational<std::int32_t>;
+    const RationalMatrix<std::int32_t> narrow{{Small{1}, Small{2}}, {Small{3}, Small{4}}};
+    REQUIRE(narrow.determinant() == Small{-2});
+    REQUIRE(narrow.inverse()(1, 0) == Small{3, 2});
+
+    constexpr auto large = std::int64_t{1} << 40;
+    REQUIRE_THROWS_AS((Matrix{{Value{large}, Value{0}}, {Value{0}, Value{large}}}.determinant()), std::overflow_error);
+}
+
+TEST_CASE("matrix_random")
+{
+    std::mt19937_64 engine{0};
+    rational::ThreadPool pool{4};
+
+    // small entries stay in 128 bits
+    std::uniform_int_distribution<std::int64_t> small{-9, 9}, denom{1, 4};
+    for (int round = 0; round < 20; ++round) {
+        const auto size = static_cast<std::size_t>(round % 8 + 1);
+        Matrix matrix{size, size};
+        for (auto& value : matrix.values()) {
+            value = Value{small(engine), denom(engine)};
+        }
+        std::vector<Value> rhs;
+        for (std::size_t i = 0; i < size; ++i) {
+            rhs.emplace_back(small(engine), denom(engine));
+        }
+
+        if (matrix.determinant() == Value{0}) {
+            REQUIRE(matrix.rank(pool) < size);
+            continue;
+        }
+        REQUIRE(matrix.rank(pool) == size);
+        REQUIRE(matrix.determinant(pool) == matrix.determinant());
+        check_solution(matrix, matrix.solve(rhs, pool), rhs);
+        const auto inverse = matrix.inverse(pool);
+        REQUIRE(inverse == matrix.inverse());
+        REQUIRE(matrix * inverse == Matrix::identity(size));
+        REQUIRE(inverse.determinant() * matrix.determinant() == Value{1});
+    }
+
+    // the elimination outgrows 128 bits and continues in BigInteger
+    for (const std::size_t size : {12, 40}) {
+        const auto matrix = unimodular_product(size, engine);
+        Value expected{1};
+        for (std::size_t i = 0; i < size; i += 3) {
+            expected = -expected;
+        }
+        REQUIRE(matrix.determinant(pool) == expected);
+        REQUIRE(matrix.rank(pool) == size);
+
+        std::vector<Value> solution;
+        for (std::size_t i = 0; i < size; ++i) {
+            solution.emplace_back(small(engine), denom(engine));
+        }
+        std::vector<Value> rhs;
+        for (std::size_t i = 0; i < size; ++i) {
+            rhs.push_back(rational::dot(matrix.row(i), solution));
+        }
+        REQUIRE(matrix.solve(rhs, pool) == solution);
+        REQUIRE(matrix.solve(rhs) == solution);
+    }
+
+    auto scaled = unimodular_product(12, engine);
+    for (auto& value : scaled.row(11)) {
+        value = value * fraction(1, 1'000'003);
+    }
+    REQUIRE(scaled.determinant(pool) == fraction(1, 1'000'003));
+
+    // rows and columns scaled by about 2^20 each, so the inverse fits but the third step does not
+    std::uniform_int_distribution<std::int64_t> factor{1 << 19, 1 << 20};
+    const auto plain = unimodular_product(6, engine);
+    std::vector<Value> left, right;
+    for (std::size_t i = 0; i < plain.rows(); ++i) {
+        left.emplace_back(factor(engine));
+        right.push_back(fraction(factor(engine), 3));
+    }
+    auto balanced = plain;
+    for (std::size_t i = 0; i < plain.rows(); ++i) {
+        for (std::size_t j = 0; j < plain.cols(); ++j) {
+            balanced(i, j) = plain(i, j) * left[i] * right[j];
+        }
+    }
+    const auto expected = plain.inverse(pool), inverse = balanced.inverse(pool);
+    REQUIRE(expected * plain == Matrix::identity(6));
+    for (std::size_t i = 0; i < plain.rows(); ++i) {
+        for (std::size_t j = 0; j < plain.cols(); ++j) {
+            REQUIRE(inverse(i, j) == expected(i, j) / right[i] / left[j]);
+        }
+    }
+    REQUIRE(inverse.inverse(pool) == balanced);
+}
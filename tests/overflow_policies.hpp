@@ -0,0 +1,14 @@
+#pragma once
+
+#include "rational_wide.hpp"
+
+// The policies of the whole test binary, shared so that every translation unit sees the same
+// specialisations: Rational<char> wraps and Rational<long long> saturates
+template <>
+struct rational::OverflowPolicy<char> {
+    using type = rational::WrapOnOverflow;
+};
+template <>
+struct rational::OverflowPolicy<long long> {
+    using type = rational::SaturateOnOverflow;
+};
@@ -0,0 +1,111 @@
+#include "rational_parallel.hpp"
+#include "overflow_policies.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+std::vector<Rational<std::int64_t>> random_rationals(std::mt19937_64& engine, std::size_t size)
+{
+    std::uniform_int_distribution<std::int64_t> numer{-1000, 1000}, denom{1, 1000};
+    std::vector<Rational<std::int64_t>> result;
+    for (std::size_t i = 0; i < size; ++i) {
+        result.emplace_back(numer(engine), denom(engine) % 3 == 0 ? 1 : std::int64_t{1} << (denom(engine) % 8));
+    }
+    return result;
+}
+}  // namespace
+
+TEST_CASE("thread_pool")
+{
+    rational::ThreadPool pool{4};
+    REQUIRE(pool.size() == 4);
+
+    std::vector<std::atomic<int>> counts(1000);
+    pool.run(counts.size(), [&](std::size_t i) { ++counts[i]; });
+    REQUIRE(std::all_of(counts.begin(), counts.end(), [](const auto& count) { return count == 1; }));
+
+    // Tasks may run nested batches without starving the pool
+    std::atomic<int> nested = 0;
+    pool.run(8, [&](std::size_t) { pool.run(8, [&](std::size_t) { ++nested; }); });
+    REQUIRE(nested == 64);
+
+    try {
+        pool.run(100, [](std::size_t i) {
+            if (i % 10 == 7) {
+                throw std::runtime_error{std::to_string(i)};
+            }
+        });
+        FAIL();
+    } catch (const std::runtime_error& error) {
+        REQUIRE(std::string{error.what()} == "7");
+    }
+}
+
+TEST_CASE("parallel_sum")
+{
+    std::mt19937_64 engine{0};
+    const auto values = random_rationals(engine, 100'000), weights = random_rationals(engine, 100'000);
+
+    rational::ThreadPool single{1}, pool{3};
+    const auto sum = rational::sum(values);
+    REQUIRE(rational::parallel_sum(values, single) == sum);
+    REQUIRE(rational::parallel_sum(values, pool) == sum);
+    REQUIRE(rational::parallel_sum(std::vector<Rational<int>>{}, pool) == Rational{0});
+
+    const auto dot = rational::dot(values, weights);
+    REQUIRE(rational::parallel_dot(values, weights, single) == dot);
+    REQUIRE(rational::parallel_dot(values, weights, pool) == dot);
+
+    // Only the combined result has to fit
+    std::vector<Rational<std::int32_t>> cancelling(50'000, Rational{std::numeric_limits<std::int32_t>::max()});
+    cancelling.resize(100'000, Rational{-std::numeric_limits<std::int32_t>::max()});
+    REQUIRE(rational::parallel_sum(cancelling, pool) == Rational{0});
+    cancelling.back() = Rational{std::numeric_limits<std::int32_t>::max()};
+    REQUIRE_THROWS_AS(rational::parallel_sum(cancelling, pool), std::overflow_error);
+}
+
+TEST_CASE("parallel_sort")
+{
+    constexpr auto max = std::numeric_limits<std::uint64_t>::max();
+
+    std::mt19937_64 engine{0};
+    auto values = random_rationals(engine, 100'000);
+    // Values whose fixed-point prefixes coincide
+    for (std::uint64_t i = 0; i < 100; ++i) {
+        values.emplace_back(std::int64_t{1}, max - i);
+        values.emplace_back(std::int64_t{-1}, max - i);
+        values.emplace_back(std::numeric_limits<std::int64_t>::max(), max - i);
+    }
+    std::shuffle(values.begin(), values.end(), engine);
+
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    rational::ThreadPool pool{3};
+    auto sorted = values;
+    rational::parallel_sort(sorted, pool);
+    REQUIRE(sorted == expected);
+
+    std::vector<Rational<std::int32_t>> narrow;
+    for (const auto& value : values) {
+        narrow.emplace_back(static_cast<std::int32_t>(value.numer() % 100'000), static_cast<std::uint32_t>(value.denom() % 1'000'000 + 1));
+    }
+    auto narrow_expected = narrow;
+    std::sort(narrow_expected.begin(), narrow_expected.end());
+    rational::parallel_sort(narrow, pool);
+    REQUIRE(narrow == narrow_expected);
+
+    auto small = std::vector{Rational{1, 3}, Rational{-1, 2}, Rational{1, 4}};
+    rational::parallel_sort(small);
+    REQUIRE(small == std::vector{Rational{-1, 2}, Rational{1, 4}, Rational{1, 3}});
+}
@@ -0,0 +1,114 @@
+#include "rational_array.hpp"
+#include "overflow_policies.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+template <std::signed_integral T>
+std::vector<Rational<T>> random_rationals(std::mt19937_64& engine, std::size_t size, std::int64_t limit)
+{
+    std::uniform_int_distribution<std::int64_t> numer{-limit, limit}, denom{1, limit};
+    std::vector<Rational<T>> result;
+    for (std::size_t i = 0; i < size; ++i) {
+        result.emplace_back(static_cast<T>(numer(engine)), static_cast<std::make_unsigned_t<T>>(denom(engine)));
+    }
+    return result;
+}
+
+template <std::signed_integral T>
+void check_operations(const std::vector<Rational<T>>& lhs, const std::vector<Rational<T>>& rhs)
+{
+    const RationalArray<T> lhs_array{lhs.begin(), lhs.end()}, rhs_array{rhs.begin(), rhs.end()};
+    const auto sum = lhs_array + rhs_array, difference = lhs_array - rhs_array, product = lhs_array * rhs_array;
+    const auto scaled = lhs_array * rhs[0].numer();
+    const auto less = lhs_array < rhs_array, equal = lhs_array == rhs_array;
+    auto divisor = rhs_array;
+    for (std::size_t i = 0; i < rhs.size(); ++i) {
+        divisor.set(i, rhs[i].numer() != 0 ? rhs[i] : Rational<T>{1});
+    }
+    const auto quotient = lhs_array / divisor;
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        REQUIRE(sum[i] == lhs[i] + rhs[i]);
+        REQUIRE(difference[i] == lhs[i] - rhs[i]);
+        REQUIRE(product[i] == lhs[i] * rhs[i]);
+        REQUIRE(scaled[i] == lhs[i] * rhs[0].numer());
+        REQUIRE(static_cast<bool>(less[i]) == (lhs[i] < rhs[i]));
+        REQUIRE(static_cast<bool>(equal[i]) == (lhs[i] == rhs[i]));
+        REQUIRE(quotient[i] == lhs[i] / divisor[i]);
+    }
+}
+}  // namespace
+
+TEST_CASE("reduce_wide")
+{
+    using rational::detail::SimdLevel;
+
+    std::mt19937_64 engine{0};
+    std::vector<std::int64_t> numer;
+    std::vector<std::uint64_t> denom;
+    for (int i = 0; i < 1000; ++i) {
+        const auto factor = engine() >> (engine() % 64);
+        const auto bits = engine() % 64;
+        numer.push_back(static_cast<std::int64_t>((engine() >> bits) * factor) >> (i % 2));
+        denom.push_back(std::max<std::uint64_t>((engine() >> bits) * factor, 1));
+    }
+    numer.push_back(0);
+    denom.push_back(std::uint64_t{1} << 63);
+    numer.push_back(std::numeric_limits<std::int64_t>::min());
+    denom.push_back(std::numeric_limits<std::uint64_t>::max() - 1);
+
+    auto expected_numer = numer;
+    auto expected_denom = denom;
+    for (std::size_t i = 0; i < numer.size(); ++i) {
+        rational::detail::reduce(expected_numer[i], expected_denom[i]);
+    }
+    for (const auto level : {SimdLevel::scalar, SimdLevel::avx2, SimdLevel::avx512}) {
+        if (level > rational::detail::simd_level()) {
+            continue;
+        }
+        auto actual_numer = numer;
+        auto actual_denom = denom;
+        rational::detail::reduce_wide(level, actual_numer.data(), actual_denom.data(), actual_numer.size());
+        REQUIRE(actual_numer == expected_numer);
+        REQUIRE(actual_denom == expected_denom);
+    }
+}
+
+TEST_CASE("rational_array")
+{
+    RationalArray<std::int32_t> array{Rational{1, 2}, Rational{-2, 3}, Rational{0}};
+    REQUIRE(array.size() == 3);
+    REQUIRE(array[1] == Rational{-2, 3});
+    REQUIRE(reinterpret_cast<std::uintptr_t>(array.numers().data()) % 64 == 0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(array.denoms().data()) % 64 == 0);
+
+    array *= 3;
+    REQUIRE(array[0] == Rational{3, 2});
+    REQUIRE(array[1] == Rational{-2});
+
+    array.numers()[2] = 6;
+    array.denoms()[2] = 4;
+    array.reduction();
+    REQUIRE(array[2] == Rational{3, 2});
+
+    REQUIRE_THROWS_AS(array + RationalArray<std::int32_t>(2), std::invalid_argument);
+    REQUIRE_THROWS_AS(array / RationalArray<std::int32_t>(3), std::range_error);
+    REQUIRE_THROWS_AS((RationalArray<std::int32_t>(5, Rational{std::numeric_limits<std::int32_t>::max()}) * 2), std::overflow_error);
+}
+
+TEST_CASE("rational_array_random")
+{
+    std::mt19937_64 engine{0};
+    check_operations(random_rationals<std::int32_t>(engine, 1000, 1 << 14), random_rationals<std::int32_t>(engine, 1000, 1 << 14));
+    check_operations(random_rationals<std::int16_t>(engine, 1000, 1 << 6), random_rationals<std::int16_t>(engine, 1000, 1 << 6));
+    check_operations(random_rationals<char>(engine, 1000, 127), random_rationals<char>(engine, 1000, 127));
+    check_operations(random_rationals<std::int64_t>(engine, 100, 1 << 30), random_rationals<std::int64_t>(engine, 100, 1 << 30));
+}
@@ -0,0 +1,117 @@
+#include "rational.hpp"
+#include "overflow_policies.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <compare>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+TEST_CASE("wide_arithmetic")
+{
+    using Rational64 = Rational<std::int64_t>;
+    constexpr std::int64_t big = (std::int64_t{1} << 62) + 1;
+
+    REQUIRE(Rational64{big, 6l} + Rational64{big, 6l} == Rational64{big, 3l});
+    REQUIRE(Rational64{-big, 6l} - Rational64{big, 6l} == Rational64{-big, 3l});
+    REQUIRE(Rational64{big, 3l} - Rational64{big, 3l} == Rational64{0l});
+    REQUIRE(Rational64{big, 3l} * Rational64{3l, 2l} == Rational64{big, 2l});
+    REQUIRE(Rational64{big, 3l} / Rational64{big, 2l} == Rational64{2l, 3l});
+    REQUIRE(Rational64{big, 3l} * 3l == Rational64{big});
+    REQUIRE(Rational64{big, 3l} / big == Rational64{1l, 3l});
+    REQUIRE(Rational64{std::numeric_limits<std::int64_t>::min()} / -2l == Rational64{std::int64_t{1} << 62});
+    REQUIRE(Rational64{std::numeric_limits<std::int64_t>::max()} - 1l == Rational64{std::numeric_limits<std::int64_t>::max() - 1});
+
+    REQUIRE(Rational<std::int8_t>{std::int8_t{1}, std::uint8_t{200}} / Rational<std::int8_t>{std::int8_t{1}, std::uint8_t{200}} == Rational<std::int8_t>{std::int8_t{1}});
+}
+
+TEST_CASE("wide_compare")
+{
+    using Rational64 = Rational<std::int64_t>;
+    constexpr auto max = std::numeric_limits<std::int64_t>::max();
+
+    const Rational64 a{max, max - 1}, b{max - 1, max - 2};
+    REQUIRE(a < b);
+    REQUIRE(b > a);
+    REQUIRE(a <= a);
+    REQUIRE(b >= a);
+    REQUIRE((a <=> b) == std::strong_ordering::less);
+    REQUIRE((a <=> a) == std::strong_ordering::equal);
+    REQUIRE(Rational64{-max, max - 1} < Rational{-1});
+    REQUIRE(Rational{1, 3} < Rational64{max, 3 * (max / 4)});
+}
+
+TEST_CASE("overflow_policy")
+{
+    using Rational64 = Rational<std::int64_t>;
+    constexpr auto max = std::numeric_limits<std::int64_t>::max();
+
+    REQUIRE_THROWS_AS(Rational64{max} + Rational64{1l}, std::overflow_error);
+    REQUIRE_THROWS_AS((Rational64{1l, max} * Rational64{1l, max - 1}), std::overflow_error);
+    REQUIRE_THROWS_AS(Rational64{max} * 2l, std::overflow_error);
+    REQUIRE_THROWS_AS((Rational<std::int8_t>{std::int8_t{1}, std::uint8_t{200}}.inverse()), std::overflow_error);
+    static_assert(!noexcept(std::declval<Rational64>() + std::declval<Rational64>()));
+
+    REQUIRE((Rational<char>{char{100}} + Rational<char>{char{100}}).numer() == char{-56});
+    static_assert(noexcept(std::declval<Rational<char>>() + std::declval<Rational<char>>()));
+
+    using Saturated = Rational<long long>;
+    constexpr auto llmax = std::numeric_limits<long long>::max();
+    constexpr auto term = static_cast<long long>(((1ull << 63) + 1) / 3);
+    REQUIRE(Saturated{llmax} + Saturated{llmax} == Saturated{llmax});
+    REQUIRE(Saturated{-llmax} - Saturated{llmax} == Saturated{std::numeric_limits<long long>::min()});
+    REQUIRE(Saturated{1ll, llmax} * Saturated{1ll, llmax - 1} == Saturated{0ll});
+    REQUIRE(Saturated{(1ll << 62) + 1, 3ll} * 2ll == Saturated{2 * term + 1, 2ll});
+    static_assert(noexcept(std::declval<Saturated>() + std::declval<Saturated>()));
+}
+
+TEST_CASE("wide_reference")
+{
+    using Rational16 = Rational<std::int16_t>;
+    const auto reference = [](std::int64_t numer, std::int64_t denom) -> std::optional<Rational16> {
+        const auto gcd = std::gcd(numer, denom);
+        numer /= gcd;
+        denom /= gcd;
+        if (denom < 0) {
+            numer = -numer;
+            denom = -denom;
+        }
+        if (numer < std::numeric_limits<std::int16_t>::min() || numer > std::numeric_limits<std::int16_t>::max() || denom > std::numeric_limits<std::uint16_t>::max()) {
+            return std::nullopt;
+        }
+        return Rational16{static_cast<std::int16_t>(numer), static_cast<std::uint16_t>(denom)};
+    };
+    const auto check = [](const std::optional<Rational16>& expected, auto&& op) {
+        if (expected) {
+            REQUIRE(op() == *expected);
+        } else {
+            REQUIRE_THROWS_AS(op(), std::overflow_error);
+        }
+    };
+
+    std::mt19937 engine{0};
+    std::uniform_int_distribution<int> numer{std::numeric_limits<std::int16_t>::min(), std::numeric_limits<std::int16_t>::max()};
+    std::uniform_int_distribution<int> denom{1, std::numeric_limits<std::uint16_t>::max()};
+    for (int i = 0; i < 10000; ++i) {
+        const Rational16 a{static_cast<std::int16_t>(numer(engine) >> (i % 15)), static_cast<std::uint16_t>(std::max(1, denom(engine) >> (i % 16)))};
+        const Rational16 b{static_cast<std::int16_t>(numer(engine) >> (i % 13)), static_cast<std::uint16_t>(std::max(1, denom(engine) >> (i % 11)))};
+        const std::int64_t an = a.numer(), ad = a.denom(), bn = b.numer(), bd = b.denom();
+
+        check(reference(an * bd + bn * ad, ad * bd), [&] { return a + b; });
+        check(reference(an * bd - bn * ad, ad * bd), [&] { return a - b; });
+        check(reference(an * bn, ad * bd), [&] { return a * b; });
+        check(reference(an + bn * ad, ad), [&] { return a + b.numer(); });
+        check(reference(an * bn, ad), [&] { return a * b.numer(); });
+        if (bn != 0) {
+            check(reference(an * bd, ad * bn), [&] { return a / b; });
+            check(reference(an, ad * bn), [&] { return a / b.numer(); });
+        }
+        REQUIRE((a < b) == (an * bd < bn * ad));
+    }
+}